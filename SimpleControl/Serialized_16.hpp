@@ -0,0 +1,37 @@
+/**
+ *  @file           Serialized_16.hpp
+ *  @brief          This class provides serialized SimpleControl data implementation for 16 bit word transports.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Each word has 15 bits of payload and a header bit, so a frame is 3 words instead of 5 octets.
+ * Header bit, padding and kinds are same as 8 bit Serialized, moved to the top of 16 bit word.
+ * Both sides of a link have to use 16 bit words.
+ */
+
+#ifndef SimpleControlSerialized_16_h
+#define SimpleControlSerialized_16_h
+
+#include "Serialized_Core.hpp"
+
+#ifndef Arduino_h
+#include <cstddef>
+#include <cstdint>
+#endif
+
+namespace SimpleControl { 
+
+  /**
+   * @brief for 16 bit word links and shared buffers, alias of __Serialized_Core< uint16_t, size_t >
+   */
+  using Serialized_16 = __Serialized_Core :: __Serialized_Core< 
+      uint16_t
+    , size_t 
+  >;
+}
+
+
+#endif /* SimpleControlSerialized_16_h */
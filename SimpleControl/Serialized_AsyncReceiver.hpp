@@ -0,0 +1,377 @@
+/**
+ *  @file           Serialized_AsyncReceiver.hpp
+ *  @brief          This class provides C++20 coroutine receiver on nonblocking file descriptor and epoll, for Linux.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * ```cpp
+ * SimpleControl :: Session session( SimpleControl :: Serialized_AsyncReceiver& receiver ){
+ *   while( std :: optional< SimpleControl :: Message > message = co_await receiver.next() )
+ *     use( message -> address, message -> data );
+ * }
+ *
+ * SimpleControl :: EventLoop                loop;
+ * SimpleControl :: Serialized_AsyncReceiver receiver( loop, fd );
+ * session( receiver );
+ * loop.run();
+ * ```
+ *
+ * `next()` / `next_batch()` complete immediately when decoded messages are available,
+ * otherwise the coroutine is suspended until the file descriptor becomes readable.
+ * Awaiters live in the coroutine frame and the receiver keeps a pointer to the waiting one,
+ * so nothing is allocated per await. Each EventLoop runs on one thread, and drives any number of receivers.
+ *
+ * This header is empty unless compiled as C++20 with `<coroutine>` on Linux.
+ */
+
+#ifndef SimpleControlSerialized_AsyncReceiver_h
+#define SimpleControlSerialized_AsyncReceiver_h
+
+#if __cplusplus >= 202002L && defined( __linux__ ) && __has_include( <coroutine> )
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Parser.hpp"
+
+#include <cerrno>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <span>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace SimpleControl {
+
+  class Serialized_AsyncReceiver;
+
+
+  /**
+   * @brief this class provides epoll event loop, resumes coroutines waiting for readable receivers
+   *
+   * @note run on one thread, use one loop per thread
+   */
+  class EventLoop {
+
+    private:
+      constexpr static int EVENTS = 64; ///< events per epoll_wait
+
+      int  _epoll; ///< epoll file descriptor
+      bool _stop;  ///< true when stop() is called
+
+      friend class Serialized_AsyncReceiver;
+
+    public:
+
+      /**
+       * @brief constructor, creates epoll instance
+       */
+      EventLoop( void ) : _epoll( epoll_create1( EPOLL_CLOEXEC ) ), _stop( false ) {}
+
+      /**
+       * @brief destructor, closes epoll instance
+       */
+      ~EventLoop( void ){
+        if( _epoll >= 0 )
+          close( _epoll );
+      }
+
+      EventLoop( const EventLoop& ) = delete;
+      EventLoop& operator= ( const EventLoop& ) = delete;
+
+
+      /**
+       * @brief checking epoll instance is available
+       */
+      bool is_open( void ) const { return _epoll >= 0; }
+
+
+      /**
+       * @brief wait for events once, and resume waiting coroutines
+       *
+       * @param[in] timeout   milliseconds to wait, -1 for infinite
+       * @return              number of events, -1 on error
+       */
+      int run_once( const int timeout = -1 );
+
+      /**
+       * @brief run until stop() is called
+       */
+      void run( void ){
+        _stop = false;
+        while( ! _stop )
+          if( run_once( -1 ) < 0 && errno != EINTR )
+            break;
+      }
+
+      /**
+       * @brief stop run(), call from a coroutine or handler on the loop thread
+       */
+      void stop( void ){ _stop = true; }
+
+  };
+
+
+
+  /**
+   * @brief this class provides awaitable receiver of messages on a file descriptor
+   *
+   * @note the file descriptor is set to nonblocking, and is not closed by this class
+   */
+  class Serialized_AsyncReceiver {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static size_type BUFFER_SIZE = 4096; ///< octets read at once
+
+    private:
+
+      /**
+       * @brief waiting request, lives in the awaiter
+       */
+      struct Request {
+        Message*                  output;   ///< buffer of decoded messages
+        size_type                 capacity; ///< number of messages of output
+        size_type                 count;    ///< number of decoded messages
+        std :: coroutine_handle<> handle;   ///< suspended coroutine
+      };
+
+      EventLoop&        _loop;   ///< event loop of this receiver
+      int               _fd;     ///< file descriptor to read
+      Serialized_Parser _parser; ///< stream parser
+
+      value_type _buffer[ BUFFER_SIZE ]; ///< read octets
+      size_type  _begin;                 ///< first unparsed octet in _buffer
+      size_type  _end;                   ///< end of read octets in _buffer
+      bool       _eof;                   ///< true after end of file or read error
+      bool       _registered;            ///< true if _fd is added to epoll
+
+      Request* _waiting; ///< request of suspended coroutine, nullptr if none
+
+      friend class EventLoop;
+
+    public:
+
+      /**
+       * @brief awaiter of next()
+       */
+      class NextAwaiter {
+        Serialized_AsyncReceiver& _receiver;
+        Message                   _message;
+        Request                   _request;
+
+        public:
+          explicit NextAwaiter( Serialized_AsyncReceiver& receiver ) :
+              _receiver( receiver ), _message(), _request{ &_message, 1, 0, {} } {}
+
+          bool await_ready( void ){ return _receiver.fill( _request ); }
+          void await_suspend( std :: coroutine_handle<> handle ){ _receiver.wait( _request, handle ); }
+
+          std :: optional< Message > await_resume( void ){
+            if( _request.count == 0 )
+              return std :: nullopt;
+            return _message;
+          }
+      };
+
+      /**
+       * @brief awaiter of next_batch()
+       */
+      class BatchAwaiter {
+        Serialized_AsyncReceiver& _receiver;
+        Request                   _request;
+
+        public:
+          BatchAwaiter( Serialized_AsyncReceiver& receiver, const std :: span< Message > output ) :
+              _receiver( receiver ), _request{ output.data(), output.size(), 0, {} } {}
+
+          bool      await_ready  ( void ){ return _request.capacity == 0 || _receiver.fill( _request ); }
+          void      await_suspend( std :: coroutine_handle<> handle ){ _receiver.wait( _request, handle ); }
+          size_type await_resume ( void ) const { return _request.count; }
+      };
+
+
+      /**
+       * @brief constructor, sets fd to nonblocking and registers it to the loop
+       *
+       * @param[in] loop  event loop which resumes coroutines of this receiver
+       * @param[in] fd    readable file descriptor ( serial port, pipe, socket, ... )
+       */
+      Serialized_AsyncReceiver( EventLoop& loop, const int fd ) :
+          _loop( loop )
+        , _fd( fd )
+        , _parser()
+        , _buffer()
+        , _begin( 0 )
+        , _end( 0 )
+        , _eof( false )
+        , _registered( false )
+        , _waiting( nullptr )
+      {
+        const int flags = fcntl( _fd, F_GETFL );
+        if( flags < 0 || fcntl( _fd, F_SETFL, flags | O_NONBLOCK ) < 0 ){
+          _eof = true;
+          return;
+        }
+
+        epoll_event event = {};
+        event.events   = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.ptr = this;
+        _registered    = epoll_ctl( _loop._epoll, EPOLL_CTL_ADD, _fd, &event ) == 0;
+        _eof           = ! _registered;
+      }
+
+      /**
+       * @brief destructor, unregisters fd from the loop
+       *
+       * @note a coroutine still waiting on this receiver is never resumed.
+       *       destroy receivers after run_once() returns, not from a resumed coroutine
+       */
+      ~Serialized_AsyncReceiver( void ){
+        if( _registered )
+          epoll_ctl( _loop._epoll, EPOLL_CTL_DEL, _fd, nullptr );
+      }
+
+      Serialized_AsyncReceiver( const Serialized_AsyncReceiver& ) = delete;
+      Serialized_AsyncReceiver& operator= ( const Serialized_AsyncReceiver& ) = delete;
+
+
+      /**
+       * @brief wait for a message
+       *
+       * @return  awaiter of `std :: optional< Message >`, empty at end of file
+       */
+      NextAwaiter next( void ){ return NextAwaiter( *this ); }
+
+      /**
+       * @brief wait for one or more messages
+       *
+       * @param[out] output   buffer of decoded messages
+       * @return              awaiter of number of decoded messages, 0 at end of file
+       */
+      BatchAwaiter next_batch( const std :: span< Message > output ){ return BatchAwaiter( *this, output ); }
+
+
+      /**
+       * @brief checking end of file
+       *
+       * @return true if fd reached end of file or an error, remaining messages may still be decoded
+       */
+      bool eof( void ) const { return _eof; }
+
+      /**
+       * @brief number of discarded frames
+       */
+      size_type invalid( void ) const { return _parser.invalid(); }
+
+
+    private:
+
+      /**
+       * @brief decode buffered octets, and read fd until request has a message or read would block
+       *
+       * @param[in,out] request   request to fill
+       * @return                  true if request is complete ( has messages or end of file )
+       */
+      bool fill( Request& request ){
+
+        for( ;; ){
+
+          if( _begin != _end ){
+            size_type count;
+            _begin += _parser.parse( _buffer + _begin, _end - _begin
+                                   , request.output   + request.count
+                                   , request.capacity - request.count
+                                   , count );
+            request.count += count;
+            if( request.count != 0 )
+              return true;
+          }
+
+          if( _eof )
+            return true;
+
+          const ssize_t length = read( _fd, _buffer, BUFFER_SIZE );
+
+          if( length > 0 ){
+            _begin = 0;
+            _end   = static_cast< size_type >( length );
+            continue;
+          }
+
+          if( length < 0 && errno == EINTR )
+            continue;
+
+          if( length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+            return false;
+
+          _eof = true;
+          return true;
+        }
+      }
+
+      /**
+       * @brief suspend a request until fd becomes readable
+       */
+      void wait( Request& request, const std :: coroutine_handle<> handle ){
+        request.handle = handle;
+        _waiting       = &request;
+      }
+
+      /**
+       * @brief called by the loop when fd is readable, resumes waiting coroutine if its request is complete
+       */
+      void readable( void ){
+
+        if( _waiting == nullptr || ! fill( *_waiting ) )
+          return;
+
+        Request* request = _waiting;
+        _waiting = nullptr;
+        request -> handle.resume();
+      }
+
+  };
+
+
+  inline int EventLoop :: run_once( const int timeout ){
+
+    epoll_event events[ EVENTS ];
+    const int   count = epoll_wait( _epoll, events, EVENTS, timeout );
+
+    for( int i = 0 ; i < count ; ++ i )
+      static_cast< Serialized_AsyncReceiver* >( events[ i ].data.ptr ) -> readable();
+
+    return count;
+  }
+
+
+
+  /**
+   * @brief fire and forget coroutine type for receiving sessions
+   *
+   * starts immediately, and frees its frame when finished. the frame is allocated once per session.
+   */
+  struct Session {
+    struct promise_type {
+      Session             get_return_object  ( void ) noexcept { return Session(); }
+      std :: suspend_never initial_suspend   ( void ) noexcept { return {}; }
+      std :: suspend_never final_suspend     ( void ) noexcept { return {}; }
+      void                 return_void       ( void ) noexcept {}
+      void                 unhandled_exception( void ) noexcept { std :: terminate(); }
+    };
+  };
+
+}
+
+#endif
+
+#endif /* SimpleControlSerialized_AsyncReceiver_h */
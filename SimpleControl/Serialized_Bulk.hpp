@@ -0,0 +1,300 @@
+/**
+ *  @file           Serialized_Bulk.hpp
+ *  @brief          This class provides bulk array frame, to transfer Data array with one Address header.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Bulk frame is consisted of 3 parts.
+ *
+ * | part    | octets                | contents                                                  |
+ * | ------- | --------------------- | --------------------------------------------------------- |
+ * | header  | `Serialized :: SIZE`  | Address frame, padding bits are `KIND_BULK` ( `0b1110****` ) |
+ * | length  | `LENGTH_SIZE`         | number of Data, 7 bit per octet, lower bits first         |
+ * | payload | `payload_size( count )` | raw bits of Data array, packed continuously into 7 bit octets |
+ *
+ * header octets have header bit, length and payload octets don't have header bit,
+ * so bulk frame is separated from other frames same as Address / Data frames.
+ */
+
+#ifndef SimpleControlSerialized_Bulk_h
+#define SimpleControlSerialized_Bulk_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+#if defined( __BMI2__ )
+#include <immintrin.h>
+#endif
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides encode/decode functions of bulk array frame
+   *
+   * All functions work on `value_type` array, so this class is available on Arduino and general C++.
+   * Payload is processed by scalar loops, 7 octets of raw data into 8 serialized octets per step
+   * with 64 bit shifts and masks, or `pdep`/`pext` instructions when BMI2 is available. No SIMD instructions are used.
+   *
+   * Sizes are computed in 32 bit, and `MAX_COUNT` is limited so that `size( MAX_COUNT )` fits in `size_type`,
+   * ex. 14329 Data on AVR where `size_t` is 16 bit.
+   */
+  class Serialized_Bulk {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static size_type HEADER_SIZE = Serialized :: SIZE;          ///< octets of header frame
+      constexpr static size_type LENGTH_SIZE = 2;                           ///< octets of length field
+
+    private:
+      constexpr static value_type bit_7        = 0b01111111;
+      constexpr static uint32_t   length_limit = (static_cast< uint32_t >( 1 ) << (7 * LENGTH_SIZE)) - 1;          ///< maximum of length field
+      constexpr static uint32_t   size_limit   = static_cast< size_type >( -1 ) < 0xFFFFFFFFUL
+                                               ? static_cast< uint32_t >( static_cast< size_type >( -1 ) )
+                                               : 0xFFFFFFFFUL;                                                       ///< maximum of size_type in 32 bit
+      constexpr static uint32_t   size_count   = (size_limit - HEADER_SIZE - LENGTH_SIZE) / (sizeof( Data ) * 8) * 7; ///< maximum count of which size() fits in size_type
+
+    public:
+      constexpr static size_type MAX_COUNT = static_cast< size_type >( length_limit < size_count ? length_limit : size_count ); ///< maximum number of Data in a bulk frame
+
+    public:
+
+      /**
+       * @brief payload octets for count Data
+       *
+       * @param[in] count number of Data, less than or equal `MAX_COUNT`
+       * @return          octets of payload, `ceil( count * 32 / 7 )`
+       */
+      constexpr static size_type payload_size( const size_type count ){
+        return static_cast< size_type >( (static_cast< uint32_t >( count ) * sizeof( Data ) * 8 + 6) / 7 );
+      }
+
+      /**
+       * @brief total octets of bulk frame for count Data
+       *
+       * @param[in] count number of Data
+       * @return          octets of header, length and payload
+       */
+      constexpr static size_type size( const size_type count ){
+        return HEADER_SIZE + LENGTH_SIZE + payload_size( count );
+      }
+
+
+      /**
+       * @brief checking first octets are header of bulk frame
+       *
+       * @param[in] input   start of serialized data
+       * @param[in] length  octets of input
+       * @return            true if input starts with header and length of bulk frame
+       */
+      static bool is_bulk( const value_type* input, const size_type length ){
+
+        if( length < HEADER_SIZE + LENGTH_SIZE )
+          return false;
+
+        if( ! Serialized( input[ 0 ], input[ 1 ], input[ 2 ], input[ 3 ], input[ 4 ] ).is_address( Serialized :: KIND_BULK ) )
+          return false;
+
+        for( size_type i = 0 ; i < LENGTH_SIZE ; ++ i )
+          if( input[ HEADER_SIZE + i ] > bit_7 )
+            return false;
+
+        return true;
+      }
+
+
+      /**
+       * @brief number of Data in bulk frame
+       *
+       * @note this function doesn't check header, use is_bulk( const value_type* input, const size_type length ) before
+       *
+       * @param[in] input start of bulk frame
+       * @return          number of Data written in length field
+       */
+      static size_type count( const value_type* input ){
+        size_type result = 0;
+        for( size_type i = 0 ; i < LENGTH_SIZE ; ++ i )
+          result |= static_cast< size_type >( input[ HEADER_SIZE + i ] & bit_7 ) << (7 * i);
+        return result;
+      }
+
+
+      /**
+       * @brief encode Data array to bulk frame
+       *
+       * @param[in]   address   Address of first Data, header frame is encoded from this value
+       * @param[in]   input     start of Data array
+       * @param[in]   count     number of Data, must be less than or equal `MAX_COUNT`
+       * @param[out]  output    start of serialized data, requires `size( count )` octets
+       * @return                octets written to output, 0 if count is over `MAX_COUNT`
+       */
+      static size_type encode( const Address& address, const Data* input, const size_type count, value_type* output ){
+
+        if( count > MAX_COUNT )
+          return 0;
+
+        Serialized header;
+        header.encode( address, Serialized :: KIND_BULK );
+
+        for( size_type i = 0 ; i < HEADER_SIZE ; ++ i )
+          output[ i ] = header[ i ];
+
+        for( size_type i = 0 ; i < LENGTH_SIZE ; ++ i )
+          output[ HEADER_SIZE + i ] = (count >> (7 * i)) & bit_7;
+
+        pack( reinterpret_cast< const value_type* >( input ), count * sizeof( Data ), output + HEADER_SIZE + LENGTH_SIZE );
+
+        return size( count );
+      }
+
+
+      /**
+       * @brief decode bulk frame to Address and Data array
+       *
+       * @param[in]   input     start of bulk frame
+       * @param[in]   length    octets of input
+       * @param[out]  address   Address of first Data
+       * @param[out]  output    start of Data array, requires `count( input )` Data
+       * @param[in]   capacity  number of Data output can store
+       * @return                octets of decoded bulk frame,
+       *                        0 if input is not bulk frame, truncated, over capacity or payload has header bit
+       */
+      static size_type decode( const value_type* input, const size_type length, Address& address, Data* output, const size_type capacity ){
+
+        if( ! is_bulk( input, length ) )
+          return 0;
+
+        const size_type n = count( input );
+        if( n > capacity || length < size( n ) )
+          return 0;
+
+        if( ! unpack( input + HEADER_SIZE + LENGTH_SIZE, n * sizeof( Data ), reinterpret_cast< value_type* >( output ) ) )
+          return 0;
+
+        Serialized( input[ 0 ], input[ 1 ], input[ 2 ], input[ 3 ], input[ 4 ] ).decode( address );
+
+        return size( n );
+      }
+
+
+
+    private:
+
+      /**
+       * @brief spread 56 bits into 8 octets of 7 bits
+       *
+       * @param[in] bits  lower 56 bits are used
+       * @return          8 octets, header bit of each octet is 0
+       */
+      static uint64_t spread( const uint64_t bits ){
+#if defined( __BMI2__ )
+        return _pdep_u64( bits, 0x7F7F7F7F7F7F7F7FULL );
+#else
+        return  (bits         & 0x000000000000007FULL)
+             | ((bits <<  1)  & 0x0000000000007F00ULL)
+             | ((bits <<  2)  & 0x00000000007F0000ULL)
+             | ((bits <<  3)  & 0x000000007F000000ULL)
+             | ((bits <<  4)  & 0x0000007F00000000ULL)
+             | ((bits <<  5)  & 0x00007F0000000000ULL)
+             | ((bits <<  6)  & 0x007F000000000000ULL)
+             | ((bits <<  7)  & 0x7F00000000000000ULL);
+#endif
+      }
+
+      /**
+       * @brief gather 8 octets of 7 bits into 56 bits, reverse of spread( const uint64_t bits )
+       *
+       * @param[in] octets  8 octets, header bit of each octet is ignored
+       * @return            56 bits
+       */
+      static uint64_t gather( const uint64_t octets ){
+#if defined( __BMI2__ )
+        return _pext_u64( octets, 0x7F7F7F7F7F7F7F7FULL );
+#else
+        return  (octets        & 0x000000000000007FULL)
+             | ((octets >>  1) & 0x0000000000003F80ULL)
+             | ((octets >>  2) & 0x00000000001FC000ULL)
+             | ((octets >>  3) & 0x000000000FE00000ULL)
+             | ((octets >>  4) & 0x00000007F0000000ULL)
+             | ((octets >>  5) & 0x000003F800000000ULL)
+             | ((octets >>  6) & 0x0001FC0000000000ULL)
+             | ((octets >>  7) & 0x00FE000000000000ULL);
+#endif
+      }
+
+      /**
+       * @brief load n octets as little endian integer
+       */
+      static uint64_t load( const value_type* input, const size_type n ){
+        uint64_t result = 0;
+        for( size_type i = 0 ; i < n ; ++ i )
+          result |= static_cast< uint64_t >( input[ i ] ) << (8 * i);
+        return result;
+      }
+
+      /**
+       * @brief store lower n octets of integer as little endian
+       */
+      static void store( uint64_t value, value_type* output, const size_type n ){
+        for( size_type i = 0 ; i < n ; ++ i, value >>= 8 )
+          output[ i ] = static_cast< value_type >( value );
+      }
+
+
+      /**
+       * @brief pack raw octets continuously into 7 bit octets
+       *
+       * @param[in]   input   start of raw octets
+       * @param[in]   length  number of raw octets
+       * @param[out]  output  start of packed octets, requires `ceil( length * 8 / 7 )` octets
+       */
+      static void pack( const value_type* input, const size_type length, value_type* output ){
+
+        const size_type steps = length / 7;
+
+        for( size_type i = 0 ; i < steps ; ++ i, input += 7, output += 8 )
+          store( spread( load( input, 7 ) ), output, 8 );
+
+        const size_type rest = length - steps * 7;
+        if( rest != 0 )
+          store( spread( load( input, rest ) ), output, (rest * 8 + 6) / 7 );
+      }
+
+      /**
+       * @brief unpack 7 bit octets into raw octets, reverse of pack( const value_type* input, const size_type length, value_type* output )
+       *
+       * @param[in]   input   start of packed octets, requires `ceil( length * 8 / 7 )` octets
+       * @param[in]   length  number of raw octets
+       * @param[out]  output  start of raw octets
+       * @return              false if any packed octet has header bit
+       */
+      static bool unpack( const value_type* input, const size_type length, value_type* output ){
+
+        const size_type steps = length / 7;
+        uint64_t        flags = 0;
+
+        for( size_type i = 0 ; i < steps ; ++ i, input += 8, output += 7 ){
+          const uint64_t octets = load( input, 8 );
+          flags |= octets;
+          store( gather( octets ), output, 7 );
+        }
+
+        const size_type rest = length - steps * 7;
+        if( rest != 0 ){
+          const uint64_t octets = load( input, (rest * 8 + 6) / 7 );
+          flags |= octets;
+          store( gather( octets ), output, rest );
+        }
+
+        return (flags & 0x8080808080808080ULL) == 0;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_Bulk_h */
@@ -27,7 +27,7 @@ namespace SimpleControl {
     /**
      * @brief this class provide basic functions for serialized class
      *
-     * @tparam    ValueType     serial data value type
+     * @tparam    ValueType     serial data value type, unsigned word of 8 bits or more. frame size is derived from its width
      * @tparam    SizeType      serial data size type
      * @tparam    Iter          iterator of data array default value is `ValueType*`
      * @tparam    ConstIter     const iterator of data array default value is `const ValueType*`
@@ -47,9 +47,29 @@ namespace SimpleControl {
           using iterator       = Iter;      ///< defined serial data iterator, used in related functions
           using const_iterator = ConstIter; ///< defined serial data const iterator, used in relatd functions
 
-          constexpr static size_type SIZE = 5; ///< defined serialzed data size
+          constexpr static size_type WORD_BITS    = sizeof( value_type ) * 8;                       ///< bits of a word, 8 for octet
+          constexpr static size_type PAYLOAD_BITS = WORD_BITS - 1;                                  ///< payload bits of a word, top bit is header bit
+          constexpr static size_type VALUE_BITS   = 32;                                             ///< bits of Address and Data
+          constexpr static size_type SIZE         = (VALUE_BITS + PAYLOAD_BITS - 1) / PAYLOAD_BITS; ///< defined serialzed data size, 5 octets or 3 words of 16 bit
 
-        protected: 
+          constexpr static value_type HEADER_BIT   = static_cast< value_type >( 1ULL << PAYLOAD_BITS );                  ///< header bit of a word, set in Address class frame
+          constexpr static value_type PAYLOAD_MASK = static_cast< value_type >( (1ULL << PAYLOAD_BITS) - 1 );            ///< payload bits of a word
+          constexpr static value_type PADDING_MASK = static_cast< value_type >( PAYLOAD_MASK
+                                                   & ~((1ULL << (VALUE_BITS - (SIZE - 1) * PAYLOAD_BITS)) - 1) );          ///< unused payload bits of last word
+
+          constexpr static value_type KIND_MASK         = static_cast< value_type >( 0b111ULL << (WORD_BITS - 4) ); ///< padding bits of last octet, used as frame kind
+          constexpr static value_type KIND_ADDRESS      = static_cast< value_type >( 0b111ULL << (WORD_BITS - 4) ); ///< kind of plain Address frame, followed by Data frame
+          constexpr static value_type KIND_BULK         = static_cast< value_type >( 0b110ULL << (WORD_BITS - 4) ); ///< kind of bulk array header, see Serialized_Bulk
+          constexpr static value_type KIND_QUANTIZED_14 = static_cast< value_type >( 0b101ULL << (WORD_BITS - 4) ); ///< kind of Address frame, followed by 14 bit quantized frame
+          constexpr static value_type KIND_QUANTIZED_21 = static_cast< value_type >( 0b100ULL << (WORD_BITS - 4) ); ///< kind of Address frame, followed by 21 bit quantized frame
+          constexpr static value_type KIND_CHECK        = static_cast< value_type >( 0b011ULL << (WORD_BITS - 4) ); ///< kind of integrity frame, see Serialized_Integrity
+          constexpr static value_type KIND_SYNC         = static_cast< value_type >( 0b010ULL << (WORD_BITS - 4) ); ///< kind of state version marker, see Serialized_StateSync
+          constexpr static value_type KIND_CREDIT       = static_cast< value_type >( 0b001ULL << (WORD_BITS - 4) ); ///< kind of flow control credit frame, see Serialized_Credit
+          constexpr static value_type KIND_DATA         = static_cast< value_type >( 0b000ULL << (WORD_BITS - 4) ); ///< kind of plain Data frame
+
+          static_assert( (KIND_MASK & PADDING_MASK) == KIND_MASK, "kind bits have to be in padding bits of last word" );
+
+        protected:
           value_type _data[ SIZE ]; ///< raw serialized data
 
         public:
@@ -57,7 +77,8 @@ namespace SimpleControl {
           /** 
            * @brief constructor for value_types
            *
-           * basic constructor for Serialized class, other constructors inherits this function
+           * basic constructor for Serialized class, other constructors inherits this function.
+           * values over SIZE are ignored, ex. v4 and v5 of 16 bit words
            *
            * @param[in]   v1    value for 1st octet data
            * @param[in]   v2    value for 2nd octet data 
@@ -71,9 +92,12 @@ namespace SimpleControl {
               , const value_type v3 = 0
               , const value_type v4 = 0
               , const value_type v5 = 0
-              ) :
-            _data{ v1, v2, v3, v4, v5 }
-          {}
+              )
+          {
+            const value_type values[ 5 ] = { v1, v2, v3, v4, v5 };
+            for( size_type i = 0 ; i < SIZE ; ++ i )
+              _data[ i ] = i < 5 ? values[ i ] : 0;
+          }
 
           /**
            * @brief copy constructor
@@ -83,15 +107,9 @@ namespace SimpleControl {
            *
            * @param[in]   other   base of __Serialized_Core class 
            */
-          __Serialized_Core ( const __Serialized_Core& other ) :
-            __Serialized_Core ( 
-                  other._data[ 0 ]
-                , other._data[ 1 ]
-                , other._data[ 2 ]
-                , other._data[ 3 ]
-                , other._data[ 4 ]
-                )
-          {}
+          __Serialized_Core ( const __Serialized_Core& other ){
+            copy( other.begin(), other.end(), begin() );
+          }
 
           /**
            * @brief constructor from `value_type [ SIZE ]` array
@@ -103,15 +121,9 @@ namespace SimpleControl {
            *
            * @param[in]   array   reference of `value_type[ SIZE ]`
            */
-          __Serialized_Core ( const value_type (&array)[ SIZE ] ) : 
-            __Serialized_Core ( 
-                array[ 0 ]
-                , array[ 1 ]
-                , array[ 2 ]
-                , array[ 3 ]
-                , array[ 4 ]
-                )
-          {}
+          __Serialized_Core ( const value_type (&array)[ SIZE ] ){
+            copy( array, array + SIZE, begin() );
+          }
 
           /**
            * @brief constructor from SimpleControl :: Address 
@@ -316,10 +328,10 @@ namespace SimpleControl {
            * @brief clear Serialized data
            *
            * zero cleared serialized data.
-           * called encode_core( const Type& input, const bool is_address ) function
            */
           void clear( void ){
-            __Serialized_Core();
+            for( iterator iter = begin(), stop = end() ; iter != stop ; ++ iter )
+              *iter = 0;
           }
 
 
@@ -330,16 +342,25 @@ namespace SimpleControl {
            *
            * @return true if data is Address compatible, otherwise false
            */
-          const bool is_address( void ) const& noexcept { 
+          bool is_address( void ) const& noexcept {
+            return is_address( KIND_ADDRESS );
+          }
+
+          /**
+           * @brief checking serial data is address class frame of specific kind
+           *
+           * all octets have header bit, and padding bits of last octet equal to kind.
+           *
+           * @param[in]   kind    expected frame kind, ex. `KIND_ADDRESS`, `KIND_BULK`
+           * @return true if data is address class frame of the kind, otherwise false
+           */
+          bool is_address( const value_type kind ) const& noexcept {
 
             for( const_iterator iter = begin(), stop = end() ; iter != stop ; ++ iter )
-              if( *iter < 0b10000000 ) 
+              if( (*iter & HEADER_BIT) == 0 )
                 return false;
 
-            if( (*(end() - 1) & 0b11110000) != 0b11110000 ) 
-              return false;
-
-            return true;
+            return this -> kind() == kind;
           }
 
           /**
@@ -349,15 +370,36 @@ namespace SimpleControl {
            *
            * @return true if serial data is Data compatible, otherwise false
            */
-          const bool is_data( void ) const& noexcept {
+          bool is_data( void ) const& noexcept {
+            return is_data( KIND_DATA );
+          }
+
+          /**
+           * @brief checking serial data is data class frame of specific kind
+           *
+           * no octets have header bit, and padding bits of last octet equal to kind.
+           *
+           * @param[in]   kind    expected frame kind, ex. `KIND_DATA`
+           * @return true if data is data class frame of the kind, otherwise false
+           */
+          bool is_data( const value_type kind ) const& noexcept {
             for( const_iterator iter = begin(), stop = end() ; iter != stop ; ++ iter )
-              if( *iter > 0b01111111 )
+              if( (*iter & HEADER_BIT) != 0 )
                 return false;
 
-            if( (*(end() - 1) & 0b01110000) != 0b01110000 )
-              return false;
+            return this -> kind() == kind;
+          }
 
-            return true;
+          /**
+           * @brief padding bits of last octet
+           *
+           * encode_core writes `0b111` for Address and `0b000` for Data,
+           * other values are used by extended frames ( ex. Serialized_Bulk ).
+           *
+           * @return padding bits of last octet, masked by `KIND_MASK`
+           */
+          value_type kind( void ) const& noexcept {
+            return *(end() - 1) & KIND_MASK;
           }
 
           /**
@@ -367,7 +409,7 @@ namespace SimpleControl {
            *
            * @return true if serial data is compatible Address or Data, otherwise false
            */
-          const bool is_correct( void ) const& noexcept { 
+          bool is_correct( void ) const& noexcept { 
             return is_address() || is_data();
           }
 
@@ -412,10 +454,25 @@ namespace SimpleControl {
            *
            * @param[in] input original data of Serialized data
            */
-          void encode( const Address& input ){ 
+          void encode( const Address& input ){
             encode_core( input, true );
           }
 
+          /**
+           * @brief encode Address value as address class frame of specific kind
+           *
+           * encoded same as encode( const Address& input ), after that padding bits are replaced by kind
+           *
+           * @param[in] input original data of Serialized data
+           * @param[in] kind  frame kind, ex. `KIND_BULK`
+           */
+          void encode( const Address& input, const value_type kind ){
+            encode_core( input, true );
+
+            value_type& last = *(end() - 1);
+            last = static_cast< value_type >( (last & ~KIND_MASK) | (kind & KIND_MASK) );
+          }
+
 
 
 
@@ -445,121 +502,40 @@ namespace SimpleControl {
           /**
            * @brief decode from Serialized data to Type value
            *
-           * @tparam     Type     output value type of this function
+           * @tparam     Type     output value type of this function, 32 bits
            *
            * @param[out] output   address of decode data from Serialized data 
            *
            *
-           * ### inspection
-           *
-           * ```
-           * decoded data byte     lower byte process                              upper byte process
-           *                       Serialized byte    bit mask       bit shift     Serialized byte      bit mask     bit shift 
-           * --------------------------------------------------------------------------------------------------------------------
-           *           byte(0) = ( (serialdata[ 0 ] & 0111 1111) >>          0 ) | ( (serialdata[ 1 ] & 0000 0001) <<        7 );
-           *           byte(1) = ( (serialdata[ 1 ] & 0111 1110) >>          1 ) | ( (serialdata[ 2 ] & 0000 0011) <<        6 );
-           *           byte(2) = ( (serialdata[ 2 ] & 0111 1100) >>          2 ) | ( (serialdata[ 3 ] & 0000 0111) <<        5 );
-           *           byte(3) = ( (serialdata[ 3 ] & 0111 1000) >>          3 ) | ( (serialdata[ 4 ] & 0000 1111) <<        4 );
-           *           byte(4) = ( (serialdata[ 4 ] & 0111 0000) >>          4 ) | ( (serialdata[ 5 ] & 0001 1111) <<        3 );
-           *           byte(5) = ( (serialdata[ 5 ] & 0110 0000) >>          5 ) | ( (serialdata[ 6 ] & 0011 1111) <<        2 );
-           *           byte(6) = ( (serialdata[ 6 ] & 0100 0000) >>          6 ) | ( (serialdata[ 7 ] & 0111 1111) <<        1 );
-           *           byte(7) = ( (serialdata[ 8 ] & 0111 1111) >>          7 ) | ( (serialdata[ 9 ] & 0000 0001) <<        0 );
-           * ```
-           *
-           * ### lower byte mask
-           *
-           * ```
-           * index : lower byte mask   ->   + 1000 0000 ->   - 0000 0001  -> bit inversion
-           * -------------------------   --------------   ---------------    ----------------
-           *     0 : 0111 1111            0 : 1111 1111    0 : 1111 1110     0 : 0000 0001
-           *     1 : 0111 1110            1 : 1111 1110    1 : 1111 1101     1 : 0000 0010
-           *     2 : 0111 1100            2 : 1111 1100    2 : 1111 1011     2 : 0000 0100
-           *     3 : 0111 1000            3 : 1111 1000    3 : 1111 0111     3 : 0000 1000
-           *     4 : 0111 0000            4 : 1111 0000    4 : 1110 1111     4 : 0001 0000
-           *     5 : 0110 0000            5 : 1110 0000    5 : 1101 1111     5 : 0010 0000
-           *     6 : 0100 0000            6 : 1100 0000    6 : 1011 1111     6 : 0100 0000
-           *     7 : 0111 1111            7 : 1111 1111    7 : 1111 1110     7 : 0000 0001
-           *     8 : 0111 1110            8 : 1111 1110    8 : 1111 1101     8 : 0000 0010
-           *     9 : 0111 1100            9 : 1111 1100    9 : 1111 1011     9 : 0000 0100
-           *     ....                     ....             ....              ....
-           * ```
+           * ### layout
            *
-           *  lower byte mask + 1000 0000 - 0000 0001  = ~( 0000 0001 << index % 7 )
-           *  lower byte mask                          = ~( 0000 0001 << index % 7 ) - 0111 1111
+           * word i carries bits `[ i * PAYLOAD_BITS, (i + 1) * PAYLOAD_BITS )` of the value, least significant first.
            *
-           *
-           * ### upper byte mask
-           * 
            * ```
-           * index : upper byte mask  ->  bit inversion -> left bit shift 
-           * ------------------------    --------------    ---------------
-           *     0 : 0000 0001            0 : 1111 1110     0 : 0111 1111
-           *     1 : 0000 0011            1 : 1111 1100     1 : 0111 1110
-           *     2 : 0000 0111            2 : 1111 1000     2 : 0111 1100
-           *     3 : 0000 1111            3 : 1111 0000     3 : 0111 1000
-           *     4 : 0001 1111            4 : 1110 0000     4 : 0111 0000
-           *     5 : 0011 1111            5 : 1100 0000     5 : 0110 0000
-           *     6 : 0111 1111            6 : 1000 0000     6 : 0100 0000
-           *     7 : 0000 0001            7 : 1111 1110     7 : 0111 1111
-           *     8 : 0000 0011            8 : 1111 1100     8 : 0111 1110
-           *     9 : 0000 0111            9 : 1111 1000     9 : 0111 1100
-           *     ....                     ....              .....
+           * word     8 bit ( octet )                      16 bit
+           * ---------------------------------------------------------------------------------
+           *    0     h 6543210                            h edcba9876543210
+           *    1     h dcba987                            h ...              bits 15 - 29
+           *    2     h ...        bits 14 - 20            h ppppppppppppp10  bits 30 - 31
+           *    3     h ...        bits 21 - 27
+           *    4     h ppp 3210   bits 28 - 31
            * ```
            *
-           *
-           * ~upper byte mask >> 1 =   lower bit mask
-           * ~upper byte mask      =   lower bit mask << 1
-           *  upper byte mask      = ~(lower bit mask << 1)
-           *
-           *
-           * ### byte index
-           *
-           * ```
-           *         byte index
-           * index : lower : upper
-           * -----------------------
-           *     0 :     0 :     1
-           *     1 :     1 :     2
-           *     2 :     2 :     3
-           *     3 :     3 :     4
-           *     4 :     4 :     5
-           *     5 :     5 :     6
-           *     6 :     6 :     7
-           *     7 :     8 :     9
-           *     8 :     9 :    10
-           *     9 :    10 :    11
-           * .....
-           * ```
-           * 
-           * upper byte index = lower byte index + 1
-           * lower byte index = index + (index / 7);
-           *
+           * `h` is header bit, `p` is padding bits, `KIND_MASK` is top 3 padding bits.
            */
            template < typename Type > 
            void decode_core ( Type& output ){
-             union {
-               Type data;
-               value_type octet[ sizeof( Type ) ];
-             } converted;
-
-             constexpr value_type bit_7 = 0b01111111;
-             constexpr value_type bit_1 = 0b00000001;
 
-             constexpr value_type octet_bit = sizeof( value_type ) * 8 - 1;
+             static_assert( sizeof( Type ) * 8 == VALUE_BITS, "Type has to be 32 bits" );
 
-             constexpr size_type size = sizeof( Data );
-             for( size_type index = 0 ; index < size ; ++ index ){ 
-
-               const value_type lower_byte_mask = ~( bit_1 << ( index % octet_bit ) ) - bit_7;
-               const value_type upper_byte_mask = ~( lower_byte_mask << 1 );
-
-               const value_type pos = index + index / octet_bit;
-
-               const value_type lower_byte = ( _data[ pos     ] & lower_byte_mask ) >> index;
-               const value_type upper_byte = ( _data[ pos + 1 ] & upper_byte_mask ) << ( octet_bit - index );
+             union {
+               Type     data;
+               uint32_t bits;
+             } converted;
 
-               converted.octet[ index ] = upper_byte | lower_byte;
-             }
+             converted.bits = 0;
+             for( size_type index = 0 ; index < SIZE ; ++ index )
+               converted.bits |= static_cast< uint32_t >( static_cast< uint32_t >( _data[ index ] & PAYLOAD_MASK ) << (index * PAYLOAD_BITS) );
 
              output = converted.data;
            }
@@ -569,223 +545,39 @@ namespace SimpleControl {
            *
            * @brief encode value to Serialized class, stored encode data
            *
-           * @tparam Type input type value of this function
+           * @tparam Type input type value of this function, 32 bits
            *
            * @param[in]   input       a original data to serialized
            * @param[in]   is_address  flag `true` when encode SimpleControl :: Address variable
            *
+           * layout is same as decode_core( Type& output ).
            *
-           * ### inspection
-           *
-           * ```
-           * serial data byte   lower byte process                       upper byte process
-           *                    data byte        bitmask     bit shift    data byte        bit mask    bit shift
-           * ---------------------------------------------------------------------------------------------------
-           *         data(01) = databyte[  0 ] & 0b0111 1111 >>       0 | databyte[  * ] & 0b0000 0000 <<      *
-           *         data(02) = databyte[  0 ] & 0b1000 0000 >>       7 | databyte[  1 ] & 0b0011 1111 <<      1
-           *         data(03) = databyte[  1 ] & 0b1100 0000 >>       6 | databyte[  2 ] & 0b0001 1111 <<      2
-           *         data(04) = databyte[  2 ] & 0b1110 0000 >>       5 | databyte[  3 ] & 0b0000 1111 <<      3
-           *         data(05) = databyte[  3 ] & 0b1111 0000 >>       4 | databyte[  4 ] & 0b0000 0111 <<      4
-           *         data(06) = databyte[  4 ] & 0b1111 1000 >>       3 | databyte[  5 ] & 0b0000 0011 <<      5
-           *         data(07) = databyte[  5 ] & 0b1111 1100 >>       2 | databyte[  6 ] & 0b0000 0001 <<      6
-           *         data(08) = databyte[  6 ] & 0b1111 1110 >>       1 | databyte[  * ] & 0b0000 0000 <<      *
-           *         data(09) = databyte[  7 ] & 0b0111 1111 >>       0 | databyte[  * ] & 0b0000 0000 <<      *
-           *         data(10) = databyte[  7 ] & 0b1000 0000 >>       7 | databyte[  8 ] & 0b0011 1111 <<      1
-           *         data(11) = databyte[  8 ] & 0b1100 0000 >>       6 | databyte[  9 ] & 0b0001 1111 <<      2
-           *         data(12) = databyte[  9 ] & 0b1110 0000 >>       5 | databyte[ 10 ] & 0b0000 1111 <<      3
-           *         data(13) = databyte[ 10 ] & 0b1111 0000 >>       4 | databyte[ 11 ] & 0b0000 0111 <<      4
-           *         data(14) = databyte[ 11 ] & 0b1111 1000 >>       3 | databyte[ 12 ] & 0b0000 0011 <<      5
-           *         data(15) = databyte[ 12 ] & 0b1111 1100 >>       2 | databyte[ 13 ] & 0b0000 0001 <<      6
-           *         data(16) = databyte[ 13 ] & 0b1111 1110 >>       1 | databyte[  * ] & 0b0000 0000 <<      *
-           *         data(17) = databyte[ 14 ] & 0b0111 1111 >>       0 | databyte[  * ] & 0b0000 0000 <<      *
-           *         data(18) = databyte[ 14 ] & 0b1000 0000 >>       7 | databyte[ 15 ] & 0b0011 1111 <<      1
-           * ```
-           *
-           *  `*` = don't care
-           *
-           * ### upper byte mask
-           *
-           * ```
-           * index: upper byte mask   -> + 0000 0001    <-  (0000 0001 << (7 - (index % 8))) & 0111 1111 +     <- index:  0000 0001 << (7 - (index % 8))
-           *                                                (0000 0001 << (7 - (index % 8))) & 1000 0000 >> 7
-           * -----------------------    ---------------     -------------------------------------------------     ---------------------------------------
-           *     0: 0000 0000              0000 0001                     0000 0001                                    0:  1000 0000                      
-           *     1: 0011 1111              0100 0000                     0100 0000                                    1:  0100 0000                      
-           *     2: 0001 1111              0010 0000                     0010 0000                                    2:  0010 0000                      
-           *     3: 0000 1111              0001 0000                     0001 0000                                    3:  0001 0000                      
-           *     4: 0000 0111              0000 1000                     0000 1000                                    4:  0000 1000                      
-           *     5: 0000 0011              0000 0100                     0000 0100                                    5:  0000 0100                      
-           *     6: 0000 0001              0000 0010                     0000 0010                                    6:  0000 0010                      
-           *     7: 0000 0000              0000 0001                     0000 0001                                    7:  0000 0001                      
-           *     8: 0000 0000              0000 0001                     0000 0001                                    8:  1000 0000                      
-           *     9: 0011 1111              0100 0000                     0100 0000                                    9:  0100 0000                      
-           * ```
-           *
-           *                     bit = 0000 0001 << (7 - (index % 8))
-           * upper byte mask = ( bit & 0111 1111 +  (bit & 1000 0000) >> 7 ) - 1
-           *
-           *
-           * ### lower byte mask
-           *
-           * ```
-           * index: lower byte mask  ->  << index % 8 == 0 ? 1 : 0    <-  index % 8 == 0 ? ~(upper byte mask + 1) :  <-    + 0000 0001   <-  index: upper byte mask 
-           *                                                                ~((upper byte mask + 1 << 1) - 1)              
-           * ----------------------     -----------------------------     ------------------------------------------    ---------------      -----------------------
-           *     0: 0111 1111            00: 1111 1110 (<< 1)              00:   1111 1110 ~(0000 0001)                 00:  0000 0001        00: 0000 0000       
-           *     1: 1000 0000            01: 1000 0000                     01:   1000 0000   ~(0111 1111)               01:  0100 0000        01: 0011 1111       
-           *     2: 1100 0000            02: 1100 0000                     02:   1100 0000   ~(0011 1111)               02:  0010 0000        02: 0001 1111       
-           *     3: 1110 0000            03: 1110 0000                     03:   1110 0000   ~(0001 1111)               03:  0001 0000        03: 0000 1111       
-           *     4: 1111 0000            04: 1111 0000                     04:   1111 0000   ~(0000 1111)               04:  0000 1000        04: 0000 0111       
-           *     5: 1111 1000            05: 1111 1000                     05:   1111 1000   ~(0000 0111)               05:  0000 0100        05: 0000 0011       
-           *     6: 1111 1100            06: 1111 1100                     06:   1111 1100   ~(0000 0011)               06:  0000 0010        06: 0000 0001       
-           *     7: 1111 1110            07: 1111 1110                     07:   1111 1110   ~(0000 0001)               07:  0000 0001        07: 0000 0000       
-           *     8: 0111 1111            08: 1111 1110 (<< 1)              08:   1111 1110 ~(0000 0001)                 08:  0000 0001        08: 0000 0000       
-           *     9: 1000 0000            09: 1000 0000                     09:   1000 0000   ~(0111 1111)               09:  0100 0000        09: 0011 1111 
-           *    10: 1100 0000            10: 1100 0000                     10:   1100 0000   ~(0011 1111)               10:  0010 0000        10: 0001 1111
-           *    11: 1110 0000            11: 1110 0000                     11:   1110 0000   ~(0001 1111)               11:  0001 0000        11: 0000 1111
-           *    12: 1111 0000            12: 1111 0000                     12:   1111 0000   ~(0000 1111)               12:  0000 1000        12: 0000 0111
-           *    13: 1111 1000            13: 1111 1000                     13:   1111 1000   ~(0000 0111)               13:  0000 0100        13: 0000 0011
-           *    14: 1111 1100            14: 1111 1100                     14:   1111 1100   ~(0000 0011)               14:  0000 0010        14: 0000 0001
-           *    15: 1111 1110            15: 1111 1110                     15:   1111 1110   ~(0000 0001)               15:  0000 0001        15: 0000 0000
-           *    16: 0111 1111            16: 1111 1110 (<< 1)              16:   1111 1110 ~(0000 0001)                 16:  0000 0001        16: 0000 0000
-           * ```
-           *
-           * lower byte mask = index % 8 == 0 ? ~(upper byte mask + 1) >> 1 : ~(upper byte mask + 1 << 1 - 1);
-           *
-           *
-           *
-           * ### upper byte array index
-           *
-           * ```
-           * index : array index -> n - (n - 1) / 8
-           * -------------------    --------
-           *     0 : *                 0
-           *     1 : 1                 1
-           *     2 : 2                 2
-           *     3 : 3                 3
-           *     4 : 4                 4
-           *     5 : 5                 5
-           *     6 : 6                 6
-           *     7 : *                 7
-           *     8 : *                 8
-           *     9 : 8                 8
-           *    10 : 9                 9
-           *    11 : 10               10
-           *    12 : 11               11
-           *    13 : 12               12
-           *    14 : 13               13
-           *    15 : *                14
-           *    16 : *                15
-           *    17 : 15               15
-           *    18 : 16               16
-           * ```
-           *
-           * `*` don't care
-           *
-           * upper byte index = index - (index - 1) / 8
-           *
-           *
-           *
-           * ### lower byte array index
-           *
-           * ```
-           *
-           * index:  array index   ->  index - 1: array index  ->  index: index == 0 ? 0 : index - (index - 1) / 8 - 1
-           * --------------------      -----------------------     -------------------------------
-           *     0:   0    0                  -1:  0   +1              0:  0
-           *     1:   0   -1                   0:  0   -0              1:  0
-           *     2:   1                        1:  1                   2:  1
-           *     3:   2                        2:  2                   3:  2
-           *     4:   3                        3:  3                   4:  3
-           *     5:   4                        4:  4                   5:  4
-           *     6:   5                        5:  5                   6:  5
-           *     7:   6                        6:  6                   7:  6
-           *     8:   7                        7:  7                   8:  7
-           *     9:   7   -2                   8:  7   -1              9:  7
-           *    10:   8                        9:  8                  10:  8
-           *    11:   9                       10:  9                  11:  9
-           *    12:  10                       11: 10                  12: 10
-           *    13:  11                       12: 11                  13: 11
-           *    14:  12                       13: 12                  14: 12
-           *    15:  13                       14: 13                  15: 13
-           *    16:  14                       15: 14                  16: 14
-           *    17:  14   -3                  16: 14   -2             17: 14
-           * ```
-           *
-           * lower byte index = index == 0 ? 0 : index - (index - 1) / 8 - 1
-           *
-           *
-           *
-           * ### header 
-           *
-           * | address      | data         |
-           * | ------------ | ------------ |
-           * | `0b1*******` | `0b0*******` | 
-           *
-           * * prepend header bit 
-           *     -> `byte | header`
-           *
-           *
-           *
-           *
-           *
-           * ### padding
-           *
-           * | address      | data         |
-           * | ------------ | ------------ |
-           * | `0b1111****` | `0b0000****` |
-           *
-           * * address padding 
-           *     -> `MSByte | 0b11110000`
-           * * data    padding 
-           *     -> `MSByte & 0b00001111`
+           * ### header and padding
            *
+           * | frame   | header bit of all words | padding bits of last word |
+           * | ------- | ----------------------- | ------------------------- |
+           * | address | 1                       | all 1, `KIND_ADDRESS`     |
+           * | data    | 0                       | all 0, `KIND_DATA`        |
            */
            template< typename Type>
            void encode_core ( const Type& input, const bool is_address = false ){
 
+             static_assert( sizeof( Type ) * 8 == VALUE_BITS, "Type has to be 32 bits" );
+
              union { 
-               Type       data;
-               value_type octet[ sizeof( Type ) ];
+               Type     data;
+               uint32_t bits;
              } original;
 
              original.data = input;
 
-             clear();
-
-             constexpr value_type bit_1     = 0b00000001;
-             constexpr value_type bit_7     = 0b01111111;
-             constexpr value_type bit_top_1 = 0b10000000;
-
-             constexpr value_type octet_bit = sizeof( value_type ) * 8 - 1;
-
-             constexpr value_type header_address = 0b10000000;
-             constexpr value_type header_data    = 0b00000000;
-
-             for( int index = 0 ; index < SIZE ; ++ index ){
-
-
-               const value_type bit             = bit_1 << ( octet_bit - (index % 8) );
-               const value_type intermediate    = (bit & bit_7) + ( (bit & bit_top_1) >> octet_bit );
-               const value_type upper_byte_mask = intermediate - 1;
-               const value_type lower_byte_mask = (index % 8 == 0) ? static_cast< value_type >( ~intermediate) >> 1 : 
-                                                                     static_cast< value_type >( ~((intermediate << 1) - 1) );
-
-               const value_type upper_byte_index = index - (index - 1) / 8;
-               const value_type lower_byte_index = index == 0 ? 0 : upper_byte_index - 1;
-
-               const value_type upper_byte = (original.octet[ upper_byte_index ] & upper_byte_mask) << index ;
-               const value_type lower_byte = (original.octet[ lower_byte_index ] & lower_byte_mask) >> (octet_bit - (index + octet_bit) % 8 ) ;
-
-               _data[ index ] = upper_byte | lower_byte | (is_address ? header_address : header_data) ;
-             }
-
+             const value_type header = is_address ? HEADER_BIT : 0;
 
-             constexpr value_type padding_address = 0b11110000;
-             constexpr value_type padding_data    = 0b00001111;
+             for( size_type index = 0 ; index < SIZE ; ++ index )
+               _data[ index ] = static_cast< value_type >( ((original.bits >> (index * PAYLOAD_BITS)) & PAYLOAD_MASK) | header );
 
              value_type& last = *(end() - 1);
-             last = is_address ? (last | padding_address) : (last & padding_data);
+             last = static_cast< value_type >( is_address ? (last | PADDING_MASK) : (last & ~PADDING_MASK) );
 
            }
 
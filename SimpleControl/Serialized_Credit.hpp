@@ -0,0 +1,118 @@
+/**
+ *  @file           Serialized_Credit.hpp
+ *  @brief          This class provides receiver side of credit based flow control, to run slow receivers at full baud rate.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Credit frame is an Address class frame, padding bits are `KIND_CREDIT` ( `0b1001****` ),
+ * and its 32 bits carry the credit limit: number of octets the sender may have sent since start, modulo 2^32.
+ *
+ * | side     | class                       | work                                                               |
+ * | -------- | --------------------------- | ------------------------------------------------------------------ |
+ * | receiver | Serialized_CreditReceiver   | counts octets read from receive buffer, makes credit frame every `interval` octets |
+ * | sender   | Serialized_CreditSender     | finds credit frames in returned octets, sends only while credit is left |
+ *
+ * Limit is `consumed + window`, so sender never has more than `window` octets in receive buffer.
+ * Each credit frame carries the whole limit, not an increment, so a lost or repeated credit frame is harmless,
+ * and receiver may repeat the last credit frame periodically as keep alive.
+ * Serialized_Parser ignores credit frames, so they can be mixed with messages returned from the receiver.
+ *
+ * Both sides count all octets on the link from start ( or reset() ), including octets which are not messages.
+ */
+
+#ifndef SimpleControlSerialized_Credit_h
+#define SimpleControlSerialized_Credit_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides receiver side of credit frames
+   *
+   * ```cpp
+   * while( Serial.available() ){
+   *   parser.parse( Serial.read(), message );
+   *   if( credit.consume( 1 ) ){
+   *     credit.encode( frame );
+   *     Serial.write( &frame[ 0 ], Serialized :: SIZE );
+   *   }
+   * }
+   * ```
+   */
+  class Serialized_CreditReceiver {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+      uint32_t _window;   ///< octets of receive buffer granted to sender
+      uint32_t _interval; ///< consumed octets per credit frame
+      uint32_t _consumed; ///< octets read from receive buffer, modulo 2^32
+      uint32_t _reported; ///< _consumed at last credit frame
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] window      octets of receive buffer granted to sender, ex. size of UART receive buffer
+       * @param[in] interval    consumed octets per credit frame, 1 or more. `window / 4` if 0
+       */
+      explicit Serialized_CreditReceiver( const uint32_t window, const uint32_t interval = 0 ) :
+          _window( window )
+        , _interval( interval != 0 ? interval : window / 4 != 0 ? window / 4 : 1 )
+        , _consumed( 0 )
+        , _reported( 0 )
+      {}
+
+
+      uint32_t window  ( void ) const { return _window;   } ///< octets of receive buffer granted to sender
+      uint32_t consumed( void ) const { return _consumed; } ///< octets read from receive buffer, modulo 2^32
+      uint32_t limit   ( void ) const { return _consumed + _window; } ///< credit limit of next credit frame
+
+
+      /**
+       * @brief count octets read from receive buffer
+       *
+       * call when octets leave the receive buffer, not when they are processed.
+       *
+       * @param[in] length  number of read octets
+       * @return            true if credit frame should be sent now
+       */
+      bool consume( const size_type length ){
+        _consumed += static_cast< uint32_t >( length );
+        return _consumed - _reported >= _interval;
+      }
+
+
+      /**
+       * @brief encode credit frame of current limit
+       *
+       * send one at start, and after each consume() returning true.
+       *
+       * @param[out] frame  credit frame
+       */
+      void encode( Serialized& frame ){
+        _reported = _consumed;
+        frame.encode( static_cast< Address >( limit() ), Serialized :: KIND_CREDIT );
+      }
+
+      /**
+       * @brief restart counting, ex. after reconnection. sender has to be reset too
+       */
+      void reset( void ){
+        _consumed = 0;
+        _reported = 0;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_Credit_h */
@@ -0,0 +1,245 @@
+/**
+ *  @file           Serialized_CreditSender.hpp
+ *  @brief          This class provides sender side of credit based flow control, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Messages are queued, and pulled as encoded octets only while credit of the receiver is left,
+ * so receive buffer of the receiver never overflows. See Serialized_Credit for credit frames.
+ *
+ * While messages wait for credit, a new message of a queued Address replaces Data of the queued one ( coalescing ),
+ * so the queue holds latest values and is bounded by number of Addresses, not by burst length.
+ * Coalescing can be disabled when every message matters, then queue can be bounded by `capacity`.
+ */
+
+#ifndef SimpleControlSerialized_CreditSender_h
+#define SimpleControlSerialized_CreditSender_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Credit.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides sender which never exceeds credit of the receiver
+   *
+   * @note this class is not thread safe
+   */
+  class Serialized_CreditSender {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static size_type MESSAGE_SIZE = Serialized :: SIZE * 2; ///< octets of an encoded message
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+
+      std :: deque< Message >                          _queue;   ///< messages waiting for credit
+      std :: unordered_map< Address, std :: uint64_t > _queued;  ///< sequence of queued message of each Address
+      std :: uint64_t                                  _front;   ///< sequence of first message in _queue
+
+      std :: uint32_t _sent;      ///< octets sent since start, modulo 2^32
+      std :: uint32_t _limit;     ///< credit limit of receiver
+      bool            _coalesce;  ///< true if messages of queued Address are coalesced
+      size_type       _capacity;  ///< maximum queued messages, 0 is unlimited
+
+      std :: uint64_t _coalesced; ///< number of coalesced messages
+      std :: uint64_t _dropped;   ///< number of messages dropped by full queue
+      std :: uint64_t _credits;   ///< number of received credit frames
+
+      Serialized _frame; ///< collecting Address class octets of returned stream
+      size_type  _count; ///< number of collected octets
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] initial   credit before the first credit frame, 0 to wait for the receiver
+       * @param[in] coalesce  true to replace Data of queued message of same Address
+       * @param[in] capacity  maximum queued messages, 0 is unlimited
+       */
+      explicit Serialized_CreditSender( const std :: uint32_t initial = 0, const bool coalesce = true, const size_type capacity = 0 ) :
+          _queue()
+        , _queued()
+        , _front( 0 )
+        , _sent( 0 )
+        , _limit( initial )
+        , _coalesce( coalesce )
+        , _capacity( capacity )
+        , _coalesced( 0 )
+        , _dropped( 0 )
+        , _credits( 0 )
+        , _frame()
+        , _count( 0 )
+      {}
+
+
+      size_type       size     ( void ) const { return _queue.size();  } ///< number of queued messages
+      bool            empty    ( void ) const { return _queue.empty(); } ///< true if no messages are queued
+      std :: uint64_t coalesced( void ) const { return _coalesced; }     ///< number of messages merged into queued ones
+      std :: uint64_t dropped  ( void ) const { return _dropped;   }     ///< number of messages dropped by full queue
+      std :: uint64_t credits  ( void ) const { return _credits;   }     ///< number of received credit frames
+
+      /**
+       * @brief octets allowed to send now
+       */
+      std :: uint32_t available( void ) const {
+        const std :: int32_t left = static_cast< std :: int32_t >( _limit - _sent );
+        return left > 0 ? static_cast< std :: uint32_t >( left ) : 0;
+      }
+
+
+      /**
+       * @brief queue a message
+       *
+       * @param[in] message   message to send
+       * @return              false if queue is full, the message is dropped
+       */
+      bool push( const Message& message ){
+
+        if( _coalesce ){
+          const std :: unordered_map< Address, std :: uint64_t > :: const_iterator queued = _queued.find( message.address );
+          if( queued != _queued.end() ){
+            _queue[ static_cast< size_type >( queued -> second - _front ) ].data = message.data;
+            ++ _coalesced;
+            return true;
+          }
+        }
+
+        if( _capacity != 0 && _queue.size() >= _capacity ){
+          ++ _dropped;
+          return false;
+        }
+
+        if( _coalesce )
+          _queued[ message.address ] = _front + _queue.size();
+        _queue.push_back( message );
+        return true;
+      }
+
+
+      /**
+       * @brief encode queued messages within credit
+       *
+       * @param[out]  output    start of serialized data
+       * @param[in]   capacity  octets output can store
+       * @return                octets written to output, multiple of `MESSAGE_SIZE`
+       */
+      size_type pull( value_type* output, const size_type capacity ){
+
+        size_type       length = 0;
+        std :: uint32_t left   = available();
+
+        while( ! _queue.empty() && length + MESSAGE_SIZE <= capacity && left >= MESSAGE_SIZE ){
+
+          const Message message = _queue.front();
+          _queue.pop_front();
+
+          if( _coalesce ){
+            const std :: unordered_map< Address, std :: uint64_t > :: iterator queued = _queued.find( message.address );
+            if( queued != _queued.end() && queued -> second == _front )
+              _queued.erase( queued );
+          }
+          ++ _front;
+
+          const Serialized address( message.address );
+          const Serialized data   ( message.data    );
+
+          for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i )
+            output[ length ++ ] = address[ i ];
+          for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i )
+            output[ length ++ ] = data[ i ];
+
+          left -= static_cast< std :: uint32_t >( MESSAGE_SIZE );
+        }
+
+        _sent += static_cast< std :: uint32_t >( length );
+        return length;
+      }
+
+      /**
+       * @brief count octets sent outside pull(), ex. integrity frames
+       *
+       * @param[in] length  number of sent octets
+       */
+      void account( const size_type length ){
+        _sent += static_cast< std :: uint32_t >( length );
+      }
+
+
+      /**
+       * @brief apply a credit limit, older limits are ignored
+       *
+       * @param[in] limit   credit limit of the receiver
+       */
+      void credit( const std :: uint32_t limit ){
+        if( static_cast< std :: int32_t >( limit - _limit ) > 0 )
+          _limit = limit;
+        ++ _credits;
+      }
+
+      /**
+       * @brief find credit frames in octets returned from the receiver
+       *
+       * other frames are skipped, pass the same octets to Serialized_Parser for returned messages.
+       * input can be split at any position.
+       *
+       * @param[in] input     start of returned octets
+       * @param[in] length    number of returned octets
+       * @return              number of found credit frames
+       */
+      size_type receive( const value_type* input, const size_type length ){
+
+        size_type found = 0;
+
+        for( size_type i = 0 ; i < length ; ++ i ){
+
+          if( (input[ i ] & header_bit) == 0 ){
+            _count = 0;
+            continue;
+          }
+
+          _frame[ _count ++ ] = input[ i ];
+          if( _count < Serialized :: SIZE )
+            continue;
+          _count = 0;
+
+          if( _frame.is_address( Serialized :: KIND_CREDIT ) ){
+            Address limit;
+            _frame.decode( limit );
+            credit( static_cast< std :: uint32_t >( limit ) );
+            ++ found;
+          }
+        }
+
+        return found;
+      }
+
+
+      /**
+       * @brief restart counting, ex. after reconnection. queued messages are kept
+       *
+       * @param[in] initial   credit before the first credit frame
+       */
+      void reset( const std :: uint32_t initial = 0 ){
+        _sent  = 0;
+        _limit = initial;
+        _count = 0;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_CreditSender_h */
@@ -0,0 +1,313 @@
+/**
+ *  @file           Serialized_FrameBuffer.hpp
+ *  @brief          This class provides structure of arrays container of encoded messages and decoded values, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Entry i of FrameBuffer is a message, stored in parallel arrays.
+ *
+ * | array         | element                                   | layout                                         |
+ * | ------------- | ----------------------------------------- | ---------------------------------------------- |
+ * | `octets()`    | Address frame + Data frame                | `STRIDE` octets per entry, contiguous, padded at the end |
+ * | `addresses()` | decoded Address                           | `Address` per entry                            |
+ * | `data()`      | decoded Data                              | `Data` per entry                               |
+ * | `kinds()`     | kind of Address frame, `INVALID` if broken | `value_type` per entry                         |
+ * | `timestamps()`| time of entry, unit is chosen by caller   | `std :: uint64_t` per entry                    |
+ *
+ * encode() and decode() convert between octets and decoded arrays for a range of entries.
+ * Each frame is converted by one 8 octets load / store, the padding keeps them in the buffer.
+ */
+
+#ifndef SimpleControlSerialized_FrameBuffer_h
+#define SimpleControlSerialized_FrameBuffer_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined( __BMI2__ )
+#include <immintrin.h>
+#endif
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides structure of arrays container of messages
+   *
+   * @note this class is not thread safe
+   */
+  class FrameBuffer {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static size_type  STRIDE  = Serialized :: SIZE * 2; ///< octets per entry, Address frame + Data frame
+      constexpr static size_type  PADDING = 32;                     ///< octets after the last entry, readable by vector loads
+      constexpr static value_type INVALID = 0xFF;                   ///< kind of entry whose octets are broken
+
+    private:
+      constexpr static value_type      header_bit = 0b10000000;
+      constexpr static std :: uint64_t bit_7      = 0x0000000F7F7F7F7FULL; ///< payload bits of a frame
+      constexpr static std :: uint64_t headers    = 0x0000008080808080ULL; ///< header bits of Address frame
+
+      std :: vector< value_type >      _octets;     ///< encoded entries and padding
+      std :: vector< Address >         _addresses;  ///< decoded Address
+      std :: vector< Data >            _data;       ///< decoded Data
+      std :: vector< value_type >      _kinds;      ///< kind of Address frame
+      std :: vector< std :: uint64_t > _timestamps; ///< time of entry
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] capacity  number of entries reserved
+       */
+      explicit FrameBuffer( const size_type capacity = 0 ) :
+          _octets( PADDING, 0 )
+        , _addresses()
+        , _data()
+        , _kinds()
+        , _timestamps()
+      {
+        reserve( capacity );
+      }
+
+
+      size_type size ( void ) const { return _addresses.size(); }  ///< number of entries
+      bool      empty( void ) const { return _addresses.empty(); } ///< true if no entry
+
+      const value_type*      octets    ( void ) const { return _octets.data(); }          ///< encoded entries, `size() * STRIDE` octets
+      size_type              octet_size( void ) const { return size() * STRIDE; }         ///< number of encoded octets
+      const Address*         addresses ( void ) const { return _addresses.data(); }       ///< decoded Address
+      const Data*            data      ( void ) const { return _data.data(); }            ///< decoded Data
+      const value_type*      kinds     ( void ) const { return _kinds.data(); }           ///< kind of Address frame
+      const std :: uint64_t* timestamps( void ) const { return _timestamps.data(); }      ///< time of entry
+
+      value_type*      octets    ( void ) { return _octets.data(); }     ///< encoded entries, `size() * STRIDE` octets
+      Address*         addresses ( void ) { return _addresses.data(); }  ///< decoded Address
+      Data*            data      ( void ) { return _data.data(); }       ///< decoded Data
+      value_type*      kinds     ( void ) { return _kinds.data(); }      ///< kind of Address frame
+      std :: uint64_t* timestamps( void ) { return _timestamps.data(); } ///< time of entry
+
+      Message message( const size_type index ) const { return Message{ _addresses[ index ], _data[ index ] }; } ///< decoded message of an entry
+
+
+      /**
+       * @brief reserve entries
+       */
+      void reserve( const size_type capacity ){
+        _octets    .reserve( capacity * STRIDE + PADDING );
+        _addresses .reserve( capacity );
+        _data      .reserve( capacity );
+        _kinds     .reserve( capacity );
+        _timestamps.reserve( capacity );
+      }
+
+      /**
+       * @brief remove all entries, capacity is kept
+       */
+      void clear( void ){
+        resize( 0 );
+      }
+
+      /**
+       * @brief change number of entries, new entries are zero
+       */
+      void resize( const size_type count ){
+        _octets    .resize( count * STRIDE + PADDING, 0 );
+        _addresses .resize( count, 0 );
+        _data      .resize( count, 0 );
+        _kinds     .resize( count, static_cast< value_type >( Serialized :: KIND_ADDRESS ) );
+        _timestamps.resize( count, 0 );
+      }
+
+
+      /**
+       * @brief append decoded messages and encode them
+       *
+       * @param[in] messages    decoded messages
+       * @param[in] count       number of messages
+       * @param[in] timestamp   time of messages
+       */
+      void append( const Message* messages, const size_type count, const std :: uint64_t timestamp = 0 ){
+
+        const size_type first = size();
+        resize( first + count );
+
+        for( size_type i = 0 ; i < count ; ++ i ){
+          _addresses [ first + i ] = messages[ i ].address;
+          _data      [ first + i ] = messages[ i ].data;
+          _timestamps[ first + i ] = timestamp;
+        }
+
+        encode( first, count );
+      }
+
+      /**
+       * @brief append a decoded message and encode it
+       */
+      void append( const Message& message, const std :: uint64_t timestamp = 0 ){ append( &message, 1, timestamp ); }
+
+      /**
+       * @brief append encoded entries and decode them
+       *
+       * @param[in] input       encoded entries, `count * STRIDE` octets
+       * @param[in] count       number of entries
+       * @param[in] timestamp   time of entries
+       * @return                number of broken entries, their kind is `INVALID`
+       */
+      size_type append_encoded( const value_type* input, const size_type count, const std :: uint64_t timestamp = 0 ){
+
+        const size_type first = size();
+        resize( first + count );
+
+        std :: memcpy( _octets.data() + first * STRIDE, input, count * STRIDE );
+        for( size_type i = 0 ; i < count ; ++ i )
+          _timestamps[ first + i ] = timestamp;
+
+        return decode( first, count );
+      }
+
+
+      /**
+       * @brief encode decoded arrays of entries into octets, as plain Address and Data frames
+       *
+       * @param[in] first   first entry
+       * @param[in] count   number of entries
+       */
+      void encode( const size_type first, const size_type count ){
+
+        value_type*      output = _octets.data() + first * STRIDE;
+        value_type* const after = output + count * STRIDE;
+
+        // each store writes 8 octets, 3 octets over the next frame. they are written again by next store,
+        // except octets after the range, so they are kept and restored
+        value_type kept[ 3 ];
+        std :: memcpy( kept, after, sizeof( kept ) );
+
+        for( size_type i = first ; i < first + count ; ++ i, output += STRIDE ){
+
+          std :: uint32_t bits;
+          std :: memcpy( &bits, &_data[ i ], sizeof( bits ) );
+
+          store( spread( _addresses[ i ] ) | headers | static_cast< std :: uint64_t >( Serialized :: KIND_ADDRESS ) << 32, output );
+          store( spread( bits ), output + Serialized :: SIZE );
+          _kinds[ i ] = Serialized :: KIND_ADDRESS;
+        }
+
+        std :: memcpy( after, kept, sizeof( kept ) );
+      }
+
+      /**
+       * @brief encode all entries
+       */
+      void encode( void ){ encode( 0, size() ); }
+
+
+      /**
+       * @brief decode octets of entries into decoded arrays
+       *
+       * @param[in] first   first entry
+       * @param[in] count   number of entries
+       * @return            number of broken entries, their kind is `INVALID`
+       */
+      size_type decode( const size_type first, const size_type count ){
+
+        const value_type* input   = _octets.data() + first * STRIDE;
+        size_type         invalid = 0;
+
+        for( size_type i = first ; i < first + count ; ++ i, input += STRIDE ){
+
+          const std :: uint64_t address = load( input )                      & 0x000000FFFFFFFFFFULL;
+          const std :: uint64_t data    = load( input + Serialized :: SIZE ) & 0x000000FFFFFFFFFFULL;
+
+          // Address frame has header bit in all octets, Data frame has none and its padding bits are KIND_DATA
+          const bool valid = ((address & headers) == headers) && ((data & headers) == 0)
+                          && ((data >> 32) & Serialized :: KIND_MASK) == Serialized :: KIND_DATA;
+
+          const std :: uint32_t bits = gather( data );
+          _addresses[ i ] = gather( address );
+          std :: memcpy( &_data[ i ], &bits, sizeof( bits ) );
+          _kinds[ i ] = valid ? static_cast< value_type >( (address >> 32) & Serialized :: KIND_MASK ) : INVALID;
+
+          invalid += valid ? 0 : 1;
+        }
+
+        return invalid;
+      }
+
+      /**
+       * @brief decode all entries
+       */
+      size_type decode( void ){ return decode( 0, size() ); }
+
+
+    private:
+
+      /**
+       * @brief spread 32 bits into 5 octets of 7 bits, the last octet has 4 bits
+       */
+      static std :: uint64_t spread( const std :: uint32_t value ){
+#if defined( __BMI2__ )
+        return _pdep_u64( value, bit_7 );
+#else
+        const std :: uint64_t bits = value;
+        return  (bits         & 0x000000000000007FULL)
+             | ((bits <<  1)  & 0x0000000000007F00ULL)
+             | ((bits <<  2)  & 0x00000000007F0000ULL)
+             | ((bits <<  3)  & 0x000000007F000000ULL)
+             | ((bits <<  4)  & 0x0000000F00000000ULL);
+#endif
+      }
+
+      /**
+       * @brief gather 5 octets of 7 bits into 32 bits, reverse of spread()
+       */
+      static std :: uint32_t gather( const std :: uint64_t octets ){
+#if defined( __BMI2__ )
+        return static_cast< std :: uint32_t >( _pext_u64( octets, bit_7 ) );
+#else
+        return static_cast< std :: uint32_t >(
+                (octets        & 0x000000000000007FULL)
+             | ((octets >>  1) & 0x0000000000003F80ULL)
+             | ((octets >>  2) & 0x00000000001FC000ULL)
+             | ((octets >>  3) & 0x000000000FE00000ULL)
+             | ((octets >>  4) & 0x00000000F0000000ULL) );
+#endif
+      }
+
+      /**
+       * @brief load 8 octets as little endian integer
+       */
+      static std :: uint64_t load( const value_type* input ){
+        std :: uint64_t result;
+        std :: memcpy( &result, input, sizeof( result ) );
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        result = __builtin_bswap64( result );
+#endif
+        return result;
+      }
+
+      /**
+       * @brief store 8 octets of little endian integer
+       */
+      static void store( std :: uint64_t value, value_type* output ){
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap64( value );
+#endif
+        std :: memcpy( output, &value, sizeof( value ) );
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_FrameBuffer_h */
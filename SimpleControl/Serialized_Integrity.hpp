@@ -0,0 +1,450 @@
+/**
+ *  @file           Serialized_Integrity.hpp
+ *  @brief          This class provides CRC32C integrity frames, to detect corrupted frames on long serial lines.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Integrity frame is an Address class frame, padding bits are `KIND_CHECK` ( `0b1011****` ),
+ * and its 32 bits carry CRC32C of all octets after the previous integrity frame ( a block ).
+ *
+ * | side     | class                        | work                                                        |
+ * | -------- | ---------------------------- | ----------------------------------------------------------- |
+ * | sender   | Serialized_IntegritySender   | accumulates sent octets, makes integrity frame every N frames |
+ * | receiver | Serialized_IntegrityChecker  | finds integrity frames in received octets, reports bad blocks |
+ *
+ * Integrity frame always follows a Data class octet, so receiver finds it by octet classes without tracking frames.
+ * Block size is decided only by sender, receiver verifies each block at each integrity frame.
+ * Serialized_Parser ignores integrity frames, so they can be enabled without changing receivers.
+ *
+ * CRC32C is computed by SSE4.2 / ARMv8 crc32 instructions when available, otherwise by table ( bitwise on Arduino ).
+ */
+
+#ifndef SimpleControlSerialized_Integrity_h
+#define SimpleControlSerialized_Integrity_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+#if defined( __SSE4_2__ )
+#include <nmmintrin.h>
+#include <cstring>
+#elif defined( __ARM_FEATURE_CRC32 )
+#include <arm_acle.h>
+#include <cstring>
+#endif
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides CRC32C ( Castagnoli ) functions
+   */
+  class Crc32c {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static uint32_t POLYNOMIAL = 0x82F63B78UL; ///< reflected polynomial of CRC32C
+      constexpr static uint32_t INITIAL    = 0xFFFFFFFFUL; ///< initial register
+
+      /**
+       * @brief update CRC register with octets
+       *
+       * @param[in] crc     CRC register, start from `INITIAL`
+       * @param[in] input   start of octets
+       * @param[in] length  number of octets
+       * @return            updated CRC register, `~crc` is CRC32C value
+       */
+      static uint32_t update( uint32_t crc, const value_type* input, size_type length ){
+
+#if defined( __SSE4_2__ ) && defined( __x86_64__ )
+        for( ; length >= 8 ; input += 8, length -= 8 ){
+          unsigned long long word;
+          std :: memcpy( &word, input, 8 );
+          crc = static_cast< uint32_t >( _mm_crc32_u64( crc, word ) );
+        }
+        if( length >= 4 ){
+          unsigned int word;
+          std :: memcpy( &word, input, 4 );
+          crc = _mm_crc32_u32( crc, word );
+          input += 4, length -= 4;
+        }
+        for( ; length != 0 ; ++ input, -- length )
+          crc = _mm_crc32_u8( crc, *input );
+        return crc;
+
+#elif defined( __SSE4_2__ )
+        for( ; length >= 4 ; input += 4, length -= 4 ){
+          unsigned int word;
+          std :: memcpy( &word, input, 4 );
+          crc = _mm_crc32_u32( crc, word );
+        }
+        for( ; length != 0 ; ++ input, -- length )
+          crc = _mm_crc32_u8( crc, *input );
+        return crc;
+
+#elif defined( __ARM_FEATURE_CRC32 )
+        for( ; length >= 8 ; input += 8, length -= 8 ){
+          uint64_t word;
+          std :: memcpy( &word, input, 8 );
+          crc = __crc32cd( crc, word );
+        }
+        for( ; length != 0 ; ++ input, -- length )
+          crc = __crc32cb( crc, *input );
+        return crc;
+
+#elif defined( Arduino_h )
+        for( ; length != 0 ; ++ input, -- length ){
+          crc ^= *input;
+          for( unsigned char bit = 0 ; bit < 8 ; ++ bit )
+            crc = (crc >> 1) ^ (POLYNOMIAL & (0 - (crc & 1)));
+        }
+        return crc;
+
+#else
+        const uint32_t* const table = Crc32c :: table();
+        for( ; length != 0 ; ++ input, -- length )
+          crc = (crc >> 8) ^ table[ (crc ^ *input) & 0xFF ];
+        return crc;
+#endif
+      }
+
+      /**
+       * @brief CRC32C of octets
+       *
+       * @param[in] input   start of octets
+       * @param[in] length  number of octets
+       * @return            CRC32C value
+       */
+      static uint32_t compute( const value_type* input, const size_type length ){
+        return ~update( INITIAL, input, length );
+      }
+
+    private:
+
+#if ! defined( __SSE4_2__ ) && ! defined( __ARM_FEATURE_CRC32 ) && ! defined( Arduino_h )
+      /**
+       * @brief lookup table of each octet, made at first call
+       */
+      static const uint32_t* table( void ){
+
+        struct Table {
+          uint32_t values[ 256 ];
+          Table( void ){
+            for( uint32_t i = 0 ; i < 256 ; ++ i ){
+              uint32_t crc = i;
+              for( int bit = 0 ; bit < 8 ; ++ bit )
+                crc = (crc >> 1) ^ (POLYNOMIAL & (0 - (crc & 1)));
+              values[ i ] = crc;
+            }
+          }
+        };
+
+        static const Table table;
+        return table.values;
+      }
+#endif
+
+  };
+
+
+
+  /**
+   * @brief this class provides sender side of integrity frames
+   *
+   * ```cpp
+   * frame.encode( address );
+   * send( frame );
+   * if( integrity.update( frame ) ){
+   *   integrity.encode( frame );
+   *   send( frame );
+   * }
+   * ```
+   */
+  class Serialized_IntegritySender {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+      uint32_t  _crc;   ///< CRC register of current block
+      size_type _block; ///< frames per block
+      size_type _count; ///< frames in current block
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] block   number of update() calls per integrity frame, 1 or more
+       */
+      explicit Serialized_IntegritySender( const size_type block = 64 ) :
+          _crc( Crc32c :: INITIAL )
+        , _block( block == 0 ? 1 : block )
+        , _count( 0 )
+      {}
+
+
+      /**
+       * @brief add sent octets to current block
+       *
+       * call with whole frames or whole messages, integrity frame is sent only between calls,
+       * and only after a Data class octet. so a full block is extended until next Data frame.
+       *
+       * @param[in] input   start of sent octets
+       * @param[in] length  number of sent octets
+       * @return            true if integrity frame should be sent now
+       */
+      bool update( const value_type* input, const size_type length ){
+        _crc = Crc32c :: update( _crc, input, length );
+        return ++ _count >= _block && length != 0 && (input[ length - 1 ] & 0b10000000) == 0;
+      }
+
+      /**
+       * @brief add a sent frame to current block
+       *
+       * @param[in] frame   sent frame
+       * @return            true if integrity frame should be sent now
+       */
+      bool update( const Serialized& frame ){
+        return update( &frame[ 0 ], Serialized :: SIZE );
+      }
+
+
+      /**
+       * @brief encode integrity frame of current block, and start next block
+       *
+       * @param[out] frame  integrity frame
+       */
+      void encode( Serialized& frame ){
+        frame.encode( static_cast< Address >( ~_crc ), Serialized :: KIND_CHECK );
+        reset();
+      }
+
+      /**
+       * @brief start next block without integrity frame, ex. after reconnection
+       */
+      void reset( void ){
+        _crc   = Crc32c :: INITIAL;
+        _count = 0;
+      }
+
+  };
+
+
+
+  /**
+   * @brief this class provides receiver side of integrity frames
+   *
+   * Integrity frames are found by octet classes, 64 octets at a time:
+   * a Data class octet, 4 Address class octets, and last octet `0b1011****`.
+   * Octets between them are passed to Crc32c at once.
+   */
+  class Serialized_IntegrityChecker {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      /**
+       * @brief report of a bad block
+       */
+      struct Block {
+        uint64_t offset;   ///< position of first octet of the block in the stream
+        uint32_t length;   ///< number of octets of the block, without integrity frame
+        uint32_t expected; ///< CRC32C in integrity frame
+        uint32_t actual;   ///< CRC32C of received octets
+      };
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+      constexpr static value_type check_mask = 0b11110000;
+      constexpr static value_type check_last = header_bit | Serialized :: KIND_CHECK;
+      constexpr static size_type  CHUNK      = 64;
+
+      uint32_t   _crc;                              ///< CRC register of current block
+      uint64_t   _offset;                           ///< position of next input octet in the stream
+      uint64_t   _start;                            ///< position of first octet of current block
+      uint64_t   _classes;                          ///< header bits of last 64 octets, last octet at MSB
+      value_type _pending[ Serialized :: SIZE - 1 ]; ///< trailing octets which may start an integrity frame, not in _crc yet
+      size_type  _held;                             ///< number of _pending octets
+
+      uint32_t _blocks; ///< number of verified blocks
+      uint32_t _bad;    ///< number of bad blocks
+
+    public:
+
+      /**
+       * @brief default constructor
+       */
+      Serialized_IntegrityChecker( void ) :
+          _crc( Crc32c :: INITIAL )
+        , _offset( 0 )
+        , _start( 0 )
+        , _classes( 0 )
+        , _pending()
+        , _held( 0 )
+        , _blocks( 0 )
+        , _bad( 0 )
+      {}
+
+
+      uint32_t blocks( void ) const { return _blocks; } ///< number of verified blocks
+      uint32_t bad   ( void ) const { return _bad;    } ///< number of bad blocks
+
+
+      /**
+       * @brief discard current block, ex. after reconnection. counters are kept
+       */
+      void reset( void ){
+        _crc     = Crc32c :: INITIAL;
+        _start   = _offset;
+        _classes = 0;
+        _held    = 0;
+      }
+
+
+      /**
+       * @brief verify received octets
+       *
+       * input can be split at any position.
+       * the first block is verified from the beginning of the stream, so start checker with the sender.
+       *
+       * @param[in]   input     start of received octets
+       * @param[in]   length    number of received octets
+       * @param[out]  bad       reports of bad blocks finished in this input, nullptr to ignore
+       * @param[in]   capacity  number of reports of bad
+       * @return                number of bad blocks finished in this input, reports over capacity are not written
+       */
+      size_type verify( const value_type* input, const size_type length, Block* bad = nullptr, const size_type capacity = 0 ){
+
+        constexpr size_type LAST = Serialized :: SIZE - 1;
+
+        size_type found    = 0;
+        size_type span     = 0;          // first input octet which is not in _crc
+        bool      resolved = _held == 0; // _pending octets are in _crc or discarded
+        uint64_t  previous = _classes;
+
+        for( size_type base = 0 ; base < length ; base += CHUNK ){
+
+          const size_type n = length - base < CHUNK ? length - base : CHUNK;
+          uint64_t address, check;
+          classify( input + base, n, address, check );
+
+          uint64_t candidates = check & ~((address << 5) | (previous >> 59));
+          for( unsigned int k = 1 ; k <= LAST ; ++ k )
+            candidates &= (address << k) | (previous >> (64 - k));
+
+          for( ; candidates != 0 ; candidates &= candidates - 1 ){
+
+            const size_type c     = base + static_cast< size_type >( __builtin_ctzll( candidates ) );
+            const size_type first = c + _held - LAST;   // position of frame in _pending + input
+
+            if( ! resolved ){
+              _crc     = Crc32c :: update( _crc, _pending, first < _held ? first : _held );
+              resolved = true;
+            }
+            if( first > _held + span )
+              _crc = Crc32c :: update( _crc, input + span, first - _held - span );
+
+            Serialized frame;
+            for( size_type k = 0 ; k <= LAST ; ++ k )
+              frame[ k ] = first + k < _held ? _pending[ first + k ] : input[ first + k - _held ];
+
+            Address expected;
+            frame.decode( expected );
+            finish( static_cast< uint32_t >( expected ), _offset + first - _held, bad, capacity, found );
+
+            span   = c + 1;
+            _start = _offset + span;
+          }
+
+          previous = n == CHUNK ? address : (address << (CHUNK - n)) | (previous >> n);
+        }
+
+        const size_type run  = previous == ~0ULL ? CHUNK : static_cast< size_type >( __builtin_clzll( ~previous ) );
+        const size_type hold = run <= LAST ? run : 0;
+        const size_type tail = length - span;
+        const size_type keep = hold > tail ? hold - tail : 0;   // old _pending octets kept
+
+        if( ! resolved )
+          _crc = Crc32c :: update( _crc, _pending, _held - keep );
+        if( tail > hold )
+          _crc = Crc32c :: update( _crc, input + span, tail - hold );
+
+        for( size_type k = 0 ; k < keep ; ++ k )
+          _pending[ k ] = _pending[ _held - keep + k ];
+        for( size_type k = keep ; k < hold ; ++ k )
+          _pending[ k ] = input[ length - (hold - k) ];
+
+        _held    = hold;
+        _classes = previous;
+        _offset += length;
+        return found;
+      }
+
+
+    private:
+
+      /**
+       * @brief finish current block by its integrity frame
+       */
+      void finish( const uint32_t expected, const uint64_t end, Block* bad, const size_type capacity, size_type& found ){
+
+        const uint32_t actual = ~_crc;
+
+        ++ _blocks;
+        if( expected != actual ){
+          ++ _bad;
+          if( bad != nullptr && found < capacity )
+            bad[ found ] = Block{ _start, static_cast< uint32_t >( end - _start ), expected, actual };
+          ++ found;
+        }
+
+        _crc = Crc32c :: INITIAL;
+      }
+
+      /**
+       * @brief make bit masks of octets, bit i is for input[ i ]
+       *
+       * @param[in]   input     start of octets
+       * @param[in]   n         number of octets, 64 or less
+       * @param[out]  address   bits of Address class octets
+       * @param[out]  check     bits of octets which look like the last octet of integrity frame
+       */
+      static void classify( const value_type* input, const size_type n, uint64_t& address, uint64_t& check ){
+
+        address = 0;
+        check   = 0;
+        size_type i = 0;
+
+#if defined( __SSE2__ )
+        const __m128i mask = _mm_set1_epi8( static_cast< char >( check_mask ) );
+        const __m128i last = _mm_set1_epi8( static_cast< char >( check_last ) );
+
+        for( ; i + 16 <= n ; i += 16 ){
+          const __m128i octets = _mm_loadu_si128( reinterpret_cast< const __m128i* >( input + i ) );
+          address |= static_cast< uint64_t >( static_cast< unsigned int >( _mm_movemask_epi8( octets ) ) ) << i;
+          check   |= static_cast< uint64_t >( static_cast< unsigned int >( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_and_si128( octets, mask ), last ) ) ) ) << i;
+        }
+#endif
+
+        for( ; i < n ; ++ i ){
+          address |= static_cast< uint64_t >( (input[ i ] & header_bit) != 0 ) << i;
+          check   |= static_cast< uint64_t >( (input[ i ] & check_mask) == check_last ) << i;
+        }
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_Integrity_h */
@@ -0,0 +1,359 @@
+/**
+ *  @file           Serialized_ParallelDecoder.hpp
+ *  @brief          This class provides parallel decoder of large captured serial data, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Input is split into chunks of about `chunk_size` octets. Start of each chunk is moved forward to
+ * the first plain Address frame ( `KIND_ADDRESS` ) after a Data class octet, it is always a boundary of frames.
+ * Chunks are decoded by Serialized_Parser on a work stealing thread pool, and messages are stitched in order.
+ *
+ * Each chunk starts with plain Address frame, which replaces last Address of Serialized_Parser,
+ * so messages are same as decoding whole input by one Serialized_Parser.
+ * Other Address class frames are not used as chunk start, because Serialized_Parser keeps last Address
+ * over integrity, version marker and credit frames, and running status Data after them needs it.
+ * invalid() may differ from one Serialized_Parser by a broken frame just before a chunk boundary.
+ */
+
+#ifndef SimpleControlSerialized_ParallelDecoder_h
+#define SimpleControlSerialized_ParallelDecoder_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Parser.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides parallel decoder on work stealing thread pool
+   *
+   * @note decode() is not reentrant, use one instance per calling thread
+   */
+  class Serialized_ParallelDecoder {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+
+      /**
+       * @brief task queue of a worker, owner pops front and thieves pop back
+       */
+      struct Queue {
+        std :: mutex             mutex; ///< guard of tasks
+        std :: deque< size_type > tasks; ///< indices of tasks
+      };
+
+      std :: vector< std :: unique_ptr< Queue > > _queues;  ///< task queues, index 0 is the calling thread
+      std :: vector< std :: thread >              _threads; ///< worker threads, worker i uses _queues[ i + 1 ]
+
+      std :: mutex              _mutex;      ///< guard of job state
+      std :: condition_variable _start;      ///< notified when a job is started or pool is stopped
+      std :: condition_variable _finish;     ///< notified when a worker finished a job
+      std :: uint64_t           _generation; ///< serial number of job
+      size_type                 _running;    ///< number of workers in current job
+      bool                      _stop;       ///< true when pool is destructed
+
+      std :: function< void( size_type ) > _job; ///< current job, called with task index
+
+      size_type _chunk_size; ///< nominal octets per chunk
+      size_type _invalid;    ///< discarded frames of last decode
+
+    public:
+
+      /**
+       * @brief constructor, starts worker threads
+       *
+       * @param[in] threads     number of threads including the calling thread, 0 for hardware concurrency
+       * @param[in] chunk_size  nominal octets per chunk
+       */
+      explicit Serialized_ParallelDecoder( unsigned int threads = 0, const size_type chunk_size = 1 << 20 ) :
+          _queues()
+        , _threads()
+        , _mutex()
+        , _start()
+        , _finish()
+        , _generation( 0 )
+        , _running( 0 )
+        , _stop( false )
+        , _job()
+        , _chunk_size( chunk_size < Serialized :: SIZE * 2 ? Serialized :: SIZE * 2 : chunk_size )
+        , _invalid( 0 )
+      {
+        if( threads == 0 )
+          threads = std :: thread :: hardware_concurrency();
+        if( threads == 0 )
+          threads = 1;
+
+        for( unsigned int i = 0 ; i < threads ; ++ i )
+          _queues.emplace_back( new Queue() );
+
+        for( unsigned int i = 1 ; i < threads ; ++ i )
+          _threads.emplace_back( &Serialized_ParallelDecoder :: worker, this, i );
+      }
+
+      /**
+       * @brief destructor, stops worker threads
+       */
+      ~Serialized_ParallelDecoder( void ){
+        {
+          std :: lock_guard< std :: mutex > lock( _mutex );
+          _stop = true;
+        }
+        _start.notify_all();
+
+        for( std :: thread& thread : _threads )
+          thread.join();
+      }
+
+      Serialized_ParallelDecoder( const Serialized_ParallelDecoder& ) = delete;
+      Serialized_ParallelDecoder& operator= ( const Serialized_ParallelDecoder& ) = delete;
+
+
+      /**
+       * @brief number of threads including the calling thread
+       */
+      size_type threads( void ) const { return _queues.size(); }
+
+      /**
+       * @brief number of discarded frames in last decode()
+       */
+      size_type invalid( void ) const { return _invalid; }
+
+
+      /**
+       * @brief decode captured serial data in parallel
+       *
+       * @param[in]   input     start of captured octets
+       * @param[in]   length    number of captured octets
+       * @param[out]  output    decoded messages in order of input, previous contents are replaced
+       * @return                number of decoded messages
+       */
+      size_type decode( const value_type* input, const size_type length, std :: vector< Message >& output ){
+
+        std :: vector< size_type > bounds = split( input, length );
+        const size_type            chunks = bounds.size() - 1;
+
+        std :: vector< std :: vector< Message > > results( chunks );
+        std :: vector< size_type >                invalid( chunks, 0 );
+
+        run( chunks, [ & ]( const size_type index ){
+            const size_type begin = bounds[ index ];
+            const size_type size  = bounds[ index + 1 ] - begin;
+
+            std :: vector< Message >& result = results[ index ];
+            result.reserve( size / (Serialized :: SIZE * 2) + 1 );
+
+            Serialized_Parser parser;
+            Message           batch[ 256 ];
+            size_type         count;
+
+            for( size_type offset = 0 ; offset < size ; ){
+              offset += parser.parse( input + begin + offset, size - offset, batch, 256, count );
+              result.insert( result.end(), batch, batch + count );
+            }
+
+            invalid[ index ] = parser.invalid();
+          } );
+
+        std :: vector< size_type > offsets( chunks + 1, 0 );
+        _invalid = 0;
+        for( size_type i = 0 ; i < chunks ; ++ i ){
+          offsets[ i + 1 ] = offsets[ i ] + results[ i ].size();
+          _invalid += invalid[ i ];
+        }
+
+        output.resize( offsets[ chunks ] );
+
+        run( chunks, [ & ]( const size_type index ){
+            std :: copy( results[ index ].begin(), results[ index ].end(), output.begin() + offsets[ index ] );
+            std :: vector< Message >().swap( results[ index ] );
+          } );
+
+        return output.size();
+      }
+
+
+    private:
+
+      /**
+       * @brief split input into chunks at frame boundaries
+       *
+       * @param[in]   input     start of captured octets
+       * @param[in]   length    number of captured octets
+       * @return                start of each chunk, and length at last
+       */
+      std :: vector< size_type > split( const value_type* input, const size_type length ) const {
+
+        std :: vector< size_type > bounds( 1, 0 );
+
+        for( size_type nominal = _chunk_size ; nominal < length ; nominal += _chunk_size ){
+
+          size_type i = nominal < bounds.back() + 1 ? bounds.back() + 1 : nominal;
+
+          while( i < length && ! is_start( input, length, i ) )
+            ++ i;
+
+          if( i >= length )
+            break;
+
+          bounds.push_back( i );
+        }
+
+        bounds.push_back( length );
+        return bounds;
+      }
+
+
+      /**
+       * @brief checking a plain Address frame starts after a Data class octet
+       *
+       * @param[in]   input     start of captured octets
+       * @param[in]   length    number of captured octets
+       * @param[in]   i         position to check, 1 or more
+       * @return                true if a chunk can start at i
+       */
+      static bool is_start( const value_type* input, const size_type length, const size_type i ){
+
+        if( (input[ i - 1 ] & header_bit) != 0 || length - i < Serialized :: SIZE )
+          return false;
+
+        Serialized frame;
+        for( size_type k = 0 ; k < Serialized :: SIZE ; ++ k ){
+          if( (input[ i + k ] & header_bit) == 0 )
+            return false;
+          frame[ k ] = input[ i + k ];
+        }
+        return frame.is_address();
+      }
+
+
+      /**
+       * @brief call job for task indices 0 - count on all threads, returns after all tasks are finished
+       *
+       * @param[in] count   number of tasks
+       * @param[in] job     function called with task index
+       */
+      void run( const size_type count, std :: function< void( size_type ) > job ){
+
+        const size_type threads = _queues.size();
+
+        for( size_type i = 0 ; i < count ; ++ i )
+          _queues[ i * threads / count ] -> tasks.push_back( i );
+
+        {
+          std :: lock_guard< std :: mutex > lock( _mutex );
+          _job     = std :: move( job );
+          _running = _threads.size();
+          ++ _generation;
+        }
+        _start.notify_all();
+
+        work( 0 );
+
+        std :: unique_lock< std :: mutex > lock( _mutex );
+        _finish.wait( lock, [ this ]{ return _running == 0; } );
+        _job = nullptr;
+      }
+
+
+      /**
+       * @brief loop of worker thread
+       *
+       * @param[in] index   index of queue of this worker
+       */
+      void worker( const size_type index ){
+
+        std :: uint64_t generation = 0;
+
+        for( ;; ){
+          {
+            std :: unique_lock< std :: mutex > lock( _mutex );
+            _start.wait( lock, [ & ]{ return _stop || _generation != generation; } );
+            if( _stop )
+              return;
+            generation = _generation;
+          }
+
+          work( index );
+
+          {
+            std :: lock_guard< std :: mutex > lock( _mutex );
+            -- _running;
+          }
+          _finish.notify_one();
+        }
+      }
+
+
+      /**
+       * @brief process own tasks, and steal tasks of other queues until all queues are empty
+       *
+       * @param[in] index   index of own queue
+       */
+      void work( const size_type index ){
+
+        const size_type threads = _queues.size();
+        size_type       task;
+
+        for( ;; ){
+
+          bool found = pop( *_queues[ index ], task, true );
+
+          for( size_type i = 1 ; ! found && i < threads ; ++ i )
+            found = pop( *_queues[ (index + i) % threads ], task, false );
+
+          if( ! found )
+            return;
+
+          _job( task );
+        }
+      }
+
+
+      /**
+       * @brief take a task from queue
+       *
+       * @param[in]   queue   task queue
+       * @param[out]  task    index of taken task
+       * @param[in]   front   true for owner ( front ), false for thief ( back )
+       * @return              false if queue is empty
+       */
+      static bool pop( Queue& queue, size_type& task, const bool front ){
+
+        std :: lock_guard< std :: mutex > lock( queue.mutex );
+
+        if( queue.tasks.empty() )
+          return false;
+
+        if( front ){
+          task = queue.tasks.front();
+          queue.tasks.pop_front();
+        }
+        else {
+          task = queue.tasks.back();
+          queue.tasks.pop_back();
+        }
+        return true;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_ParallelDecoder_h */
@@ -0,0 +1,203 @@
+/**
+ *  @file           Serialized_Parser.hpp
+ *  @brief          This class provides stream parser, to find Address / Data frames in serial octets and decode messages.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Parser collects octets into a frame. When header bit of an octet is different from collected octets,
+ * collected octets are discarded and the frame restarts from the octet, so parser is resynchronized at
+ * every boundary between Address and Data frames.
+ *
+ * Parser keeps last decoded Address, and each Data frame makes a message with it.
+ * So Data frames without preceding Address frame ( running status ) are also decoded,
+ * see Serialized_RunningStatus for sender side.
+ *
+ * Address frames of other kinds ( ex. Serialized_Bulk header ) are not decoded by this class.
+ * After them, Data class octets are skipped until next Address class octet, and last Address is forgotten.
+ * Address class frames of unknown kind are handled the same way and counted as invalid.
+ * An Address class frame interrupted by Data class octet is handled the same way,
+ * because the following Data frames belong to the lost Address, not to last Address.
+ * Integrity frames ( `KIND_CHECK` ), version markers ( `KIND_SYNC` ) and credit frames ( `KIND_CREDIT` ) are ignored,
+ * they don't change last Address.
+ */
+
+#ifndef SimpleControlSerialized_Parser_h
+#define SimpleControlSerialized_Parser_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides stream parser of Address / Data frames
+   */
+  class Serialized_Parser {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+
+      Serialized _frame;       ///< collecting frame
+      size_type  _count;       ///< number of collected octets in _frame
+      Address    _address;     ///< last decoded Address
+      bool       _has_address; ///< true if _address is available
+      bool       _skip;        ///< true while skipping Data class octets after other kind frame
+      size_type  _invalid;     ///< number of discarded frames
+
+    public:
+
+      /**
+       * @brief default constructor
+       */
+      Serialized_Parser( void ) :
+          _frame()
+        , _count( 0 )
+        , _address( 0 )
+        , _has_address( false )
+        , _skip( false )
+        , _invalid( 0 )
+      {}
+
+
+      /**
+       * @brief discard collecting frame and last Address
+       */
+      void reset( void ){
+        _count       = 0;
+        _has_address = false;
+        _skip        = false;
+      }
+
+
+      /**
+       * @brief checking last Address is available
+       *
+       * @return true if an Address frame was decoded after reset
+       */
+      bool has_address( void ) const { return _has_address; }
+
+      /**
+       * @brief last decoded Address
+       *
+       * @note available when has_address() is true
+       *
+       * @return last decoded Address
+       */
+      const Address& address( void ) const { return _address; }
+
+      /**
+       * @brief number of discarded frames
+       *
+       * counted incomplete frames interrupted by other class octet, unknown frames,
+       * and Data frames without Address
+       *
+       * @return number of discarded frames after construction
+       */
+      size_type invalid( void ) const { return _invalid; }
+
+
+      /**
+       * @brief parse an octet
+       *
+       * @param[in]   octet     received octet
+       * @param[out]  message   decoded message, written only when this function returns true
+       * @return                true if a Data frame is completed and message is decoded
+       */
+      bool parse( const value_type octet, Message& message ){
+
+        const bool is_address = (octet & header_bit) != 0;
+
+        if( _skip ){
+          if( ! is_address )
+            return false;
+          _skip = false;
+        }
+
+        if( _count != 0 && ((_frame[ 0 ] & header_bit) != 0) != is_address ){
+          _count = 0;
+          ++ _invalid;
+
+          if( ! is_address ){
+            _has_address = false;
+            _skip        = true;
+            return false;
+          }
+        }
+
+        _frame[ _count ++ ] = octet;
+
+        if( _count < Serialized :: SIZE )
+          return false;
+
+        _count = 0;
+
+        if( is_address ){
+
+          if( _frame.is_address() ){
+            _frame.decode( _address );
+            _has_address = true;
+            return false;
+          }
+
+          if(    _frame.is_address( Serialized :: KIND_CHECK )
+              || _frame.is_address( Serialized :: KIND_SYNC  )
+              || _frame.is_address( Serialized :: KIND_CREDIT ) )
+            return false;
+
+          // bulk and quantized frames are known, other kinds are unknown frames
+          _has_address = false;
+          _skip        = true;
+          if(    ! _frame.is_address( Serialized :: KIND_BULK )
+              && ! _frame.is_address( Serialized :: KIND_QUANTIZED_14 )
+              && ! _frame.is_address( Serialized :: KIND_QUANTIZED_21 ) )
+            ++ _invalid;
+          return false;
+        }
+
+        if( ! _frame.is_data() || ! _has_address ){
+          ++ _invalid;
+          return false;
+        }
+
+        message.address = _address;
+        _frame.decode( message.data );
+        return true;
+      }
+
+
+      /**
+       * @brief parse octets
+       *
+       * parsing stops when output is full or input is finished.
+       *
+       * @param[in]   input     start of received octets
+       * @param[in]   length    number of received octets
+       * @param[out]  output    start of message array
+       * @param[in]   capacity  number of messages output can store
+       * @param[out]  count     number of decoded messages
+       * @return                number of parsed octets
+       */
+      size_type parse( const value_type* input, const size_type length, Message* output, const size_type capacity, size_type& count ){
+
+        count = 0;
+
+        size_type i = 0;
+        while( i < length && count < capacity )
+          if( parse( input[ i ++ ], output[ count ] ) )
+            ++ count;
+
+        return i;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_Parser_h */
@@ -0,0 +1,225 @@
+/**
+ *  @file           Serialized_PrioritySender.hpp
+ *  @brief          This class provides sender with real-time and bulk lanes, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Messages are queued into one of 2 lanes, and pulled as encoded octets at message boundaries,
+ * so Address and Data frames of a message are never separated by other messages.
+ *
+ * * real-time lane
+ *     * messages are sent in order of deadline ( earliest deadline first )
+ * * bulk lane
+ *     * messages are sent in order of push ( ex. full state snapshot )
+ *
+ * While both lanes have messages, bulk lane uses `bulk_share` of sent octets.
+ * But a real-time message whose deadline is in `slack` is sent before any bulk messages,
+ * these preempting messages are not counted in the share.
+ * Real-time messages pushed without deadline never preempt, they are sent by the share only.
+ */
+
+#ifndef SimpleControlSerialized_PrioritySender_h
+#define SimpleControlSerialized_PrioritySender_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides 2 lanes sender, real-time lane is not blocked by bulk transfer
+   *
+   * @note this class is not thread safe
+   */
+  class Serialized_PrioritySender {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      using clock      = std :: chrono :: steady_clock; ///< clock of deadlines
+      using time_point = clock :: time_point;           ///< deadline type
+      using duration   = clock :: duration;             ///< deadline margin type
+
+      constexpr static size_type MESSAGE_SIZE = Serialized :: SIZE * 2; ///< octets of an encoded message
+
+    private:
+
+      /**
+       * @brief queued real-time message
+       */
+      struct Entry {
+        Message         message;  ///< queued message
+        time_point      deadline; ///< time the message should be sent before
+        std :: uint64_t sequence; ///< order of push, used for same deadline
+      };
+
+      /**
+       * @brief order of real-time lane, earliest deadline is top
+       */
+      struct Later {
+        bool operator() ( const Entry& lhs, const Entry& rhs ) const {
+          return lhs.deadline != rhs.deadline ? lhs.deadline > rhs.deadline : lhs.sequence > rhs.sequence;
+        }
+      };
+
+      std :: priority_queue< Entry, std :: vector< Entry >, Later > _realtime; ///< real-time lane
+      std :: deque< Message > _bulk;                                            ///< bulk lane
+
+      double          _bulk_share; ///< share of octets bulk lane uses while both lanes have messages
+      duration        _slack;      ///< real-time messages within this margin preempt bulk lane
+      std :: uint64_t _sequence;   ///< next sequence of real-time message
+      double          _balance;    ///< octets bulk lane is allowed to send, bulk lane waits while 0 or less
+      std :: uint64_t _missed;     ///< number of real-time messages sent after deadline
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] bulk_share  share of octets for bulk lane while both lanes have messages, 0 - 1
+       * @param[in] slack       real-time message whose deadline is within this margin is sent first
+       */
+      Serialized_PrioritySender( const double bulk_share = 0.25, const duration slack = std :: chrono :: milliseconds( 2 ) ) :
+          _realtime()
+        , _bulk()
+        , _bulk_share( bulk_share < 0 ? 0 : bulk_share > 1 ? 1 : bulk_share )
+        , _slack( slack )
+        , _sequence( 0 )
+        , _balance( 0 )
+        , _missed( 0 )
+      {}
+
+
+      /**
+       * @brief queue a message into real-time lane
+       *
+       * @param[in] message   message to send
+       * @param[in] deadline  time the message should be sent before
+       */
+      void push_realtime( const Message& message, const time_point deadline ){
+        _realtime.push( Entry{ message, deadline, _sequence ++ } );
+      }
+
+      /**
+       * @brief queue a message into real-time lane without deadline
+       *
+       * the message is sent after messages with deadline, and doesn't preempt bulk lane.
+       *
+       * @param[in] message   message to send
+       */
+      void push_realtime( const Message& message ){
+        push_realtime( message, time_point :: max() );
+      }
+
+      /**
+       * @brief queue a message into bulk lane
+       *
+       * @param[in] message   message to send
+       */
+      void push_bulk( const Message& message ){
+        _bulk.push_back( message );
+      }
+
+
+      size_type realtime_size( void ) const { return _realtime.size(); } ///< number of queued real-time messages
+      size_type bulk_size    ( void ) const { return _bulk.size();     } ///< number of queued bulk messages
+      bool      empty        ( void ) const { return _realtime.empty() && _bulk.empty(); } ///< true if no messages are queued
+
+      /**
+       * @brief number of real-time messages sent after their deadline
+       *
+       * @return number of missed deadlines after construction
+       */
+      std :: uint64_t missed( void ) const { return _missed; }
+
+
+      /**
+       * @brief encode queued messages
+       *
+       * messages are encoded while output has room for whole message.
+       *
+       * @param[out]  output    start of serialized data
+       * @param[in]   capacity  octets output can store
+       * @param[in]   now       current time, used for deadlines
+       * @return                octets written to output, multiple of `MESSAGE_SIZE`
+       */
+      size_type pull( value_type* output, const size_type capacity, const time_point now = clock :: now() ){
+
+        size_type length = 0;
+
+        while( length + MESSAGE_SIZE <= capacity && ! empty() ){
+
+          Message message;
+
+          if( next_is_bulk( now ) ){
+            message = _bulk.front();
+            _bulk.pop_front();
+          }
+          else {
+            const Entry& entry = _realtime.top();
+            if( entry.deadline < now )
+              ++ _missed;
+            message = entry.message;
+            _realtime.pop();
+          }
+
+          const Serialized address( message.address );
+          const Serialized data   ( message.data    );
+
+          for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i )
+            output[ length ++ ] = address[ i ];
+          for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i )
+            output[ length ++ ] = data[ i ];
+        }
+
+        return length;
+      }
+
+
+    private:
+
+      /**
+       * @brief choose a lane for next message, and account its share
+       *
+       * @param[in] now   current time
+       * @return          true if next message is taken from bulk lane
+       */
+      bool next_is_bulk( const time_point now ){
+
+        if( _realtime.empty() ){
+          _balance = 0;
+          return true;
+        }
+
+        if( _bulk.empty() ){
+          _balance = 0;
+          return false;
+        }
+
+        if( _realtime.top().deadline <= now + _slack )
+          return false;
+
+        if( _balance <= 0 ){
+          _balance += _bulk_share * MESSAGE_SIZE;
+          return false;
+        }
+
+        _balance -= (1 - _bulk_share) * MESSAGE_SIZE;
+        return true;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_PrioritySender_h */
@@ -0,0 +1,183 @@
+/**
+ *  @file           Serialized_Quantized.hpp
+ *  @brief          This class provides compact quantized Data frames, 14 bit in 2 octets and 21 bit in 3 octets.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Quantized frame follows an Address frame encoded with `KIND_QUANTIZED_14` or `KIND_QUANTIZED_21`,
+ * instead of plain Data frame.
+ *
+ * | part    | octets                       | contents                                           |
+ * | ------- | ---------------------------- | -------------------------------------------------- |
+ * | address | `Serialized :: SIZE`         | Address frame, padding bits are kind of next frame |
+ * | value   | `Serialized_Quantized :: SIZE` | fixed point value, 7 bit per octet, lower bits first |
+ *
+ * value octets don't have header bit, so Address frame is still found by `is_address( kind )`
+ * and receiver knows length of next frame from the kind.
+ * Fixed point value `q` is mapped to Data by `offset + q * scale`, scale and offset are chosen per Address.
+ */
+
+#ifndef SimpleControlSerialized_Quantized_h
+#define SimpleControlSerialized_Quantized_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief mapping between fixed point value and Data
+   *
+   * `Data = offset + q * scale`
+   */
+  struct Quantize {
+    Data offset; ///< Data of fixed point value 0
+    Data scale;  ///< Data step of fixed point value 1
+  };
+
+
+  /**
+   * @brief this class provides compact quantized Data frame
+   *
+   * @tparam    BITS    resolution of fixed point value, multiple of 7. 14 and 21 are available
+   */
+  template < unsigned int BITS >
+  class Serialized_Quantized {
+
+    static_assert( BITS == 14 || BITS == 21, "Serialized_Quantized supports 14 or 21 bit" );
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      using iterator       = value_type*;       ///< serial data iterator
+      using const_iterator = const value_type*; ///< serial data const iterator
+
+      constexpr static size_type  SIZE = BITS / 7;                                   ///< octets of quantized frame
+      constexpr static uint32_t   MAX  = (static_cast< uint32_t >( 1 ) << BITS) - 1; ///< maximum fixed point value
+      constexpr static value_type KIND = BITS == 14 ? Serialized :: KIND_QUANTIZED_14 : Serialized :: KIND_QUANTIZED_21; ///< kind of preceding Address frame
+
+    protected:
+      value_type _data[ SIZE ]; ///< raw serialized data
+
+    public:
+
+      /**
+       * @brief default constructor, zero cleared
+       */
+      Serialized_Quantized( void ) : _data{} {}
+
+
+      /**
+       * @brief Quantize maps fixed point values onto minimum to maximum
+       *
+       * @param[in] minimum   Data of fixed point value 0
+       * @param[in] maximum   Data of fixed point value `MAX`
+       * @return              Quantize for this resolution
+       */
+      static Quantize range( const Data minimum, const Data maximum ){
+        return Quantize{ minimum, (maximum - minimum) / static_cast< Data >( MAX ) };
+      }
+
+
+      /**
+       * @brief data accessor
+       *
+       * @note this function no checks out of range
+       *
+       * @param[in]     n     num of data octet
+       * @return              reference of nth octet data
+       */
+      value_type&       operator[] ( const size_type n )       { return _data[ n ]; }
+
+      /**
+       * @brief data accessor for const
+       *
+       * @note this function no checks out of range
+       *
+       * @param[in]     n     num of data octet
+       * @return              const reference of nth octet data
+       */
+      const value_type& operator[] ( const size_type n ) const { return _data[ n ]; }
+
+      iterator       begin( void )       { return _data; }        ///< iterator of first octet data
+      const_iterator begin( void ) const { return _data; }        ///< const iterator of first octet data
+      iterator       end  ( void )       { return _data + SIZE; } ///< iterator of data endpoint
+      const_iterator end  ( void ) const { return _data + SIZE; } ///< const iterator of data endpoint
+
+
+      /**
+       * @brief checking serial data is quantized frame compatible
+       *
+       * @return true if no octets have header bit
+       */
+      bool is_quantized( void ) const noexcept {
+        for( const_iterator iter = begin(), stop = end() ; iter != stop ; ++ iter )
+          if( *iter > 0b01111111 )
+            return false;
+        return true;
+      }
+
+
+      /**
+       * @brief encode fixed point value
+       *
+       * @param[in] value   fixed point value, upper bits over `BITS` are ignored
+       */
+      void encode( const uint32_t value ){
+        for( size_type i = 0 ; i < SIZE ; ++ i )
+          _data[ i ] = (value >> (7 * i)) & 0b01111111;
+      }
+
+      /**
+       * @brief quantize Data and encode
+       *
+       * Data is rounded to nearest fixed point value, and clamped to 0 - `MAX`
+       *
+       * @param[in] input     original Data
+       * @param[in] quantize  mapping of the Address
+       */
+      void encode( const Data input, const Quantize& quantize ){
+        const Data q = (input - quantize.offset) / quantize.scale + static_cast< Data >( 0.5 );
+
+        encode( ! (q > 0)                          ? 0   :
+                   q >= static_cast< Data >( MAX ) ? MAX :
+                                                     static_cast< uint32_t >( q ) );
+      }
+
+
+      /**
+       * @brief decode fixed point value
+       *
+       * @param[out] output   fixed point value
+       */
+      void decode( uint32_t& output ) const {
+        output = 0;
+        for( size_type i = 0 ; i < SIZE ; ++ i )
+          output |= static_cast< uint32_t >( _data[ i ] & 0b01111111 ) << (7 * i);
+      }
+
+      /**
+       * @brief decode and dequantize to Data
+       *
+       * @param[out] output    decoded Data
+       * @param[in]  quantize  mapping of the Address
+       */
+      void decode( Data& output, const Quantize& quantize ) const {
+        uint32_t q;
+        decode( q );
+        output = quantize.offset + static_cast< Data >( q ) * quantize.scale;
+      }
+
+  };
+
+
+  using Serialized_Quantized14 = Serialized_Quantized< 14 >; ///< 14 bit quantized frame, 2 octets
+  using Serialized_Quantized21 = Serialized_Quantized< 21 >; ///< 21 bit quantized frame, 3 octets
+
+}
+
+#endif /* SimpleControlSerialized_Quantized_h */
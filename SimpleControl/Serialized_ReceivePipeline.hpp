@@ -0,0 +1,482 @@
+/**
+ *  @file           Serialized_ReceivePipeline.hpp
+ *  @brief          This class provides pipelined receive engine, ingest / parse / dispatch on separate threads, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * | stage    | work                                                   | output                   |
+ * | -------- | ------------------------------------------------------ | ------------------------ |
+ * | ingest   | calls reader to fill a batch of octets                 | octet batch              |
+ * | parse    | decodes octets by Serialized_Parser                    | message batch            |
+ * | dispatch | calls handler with a batch of messages                 | -                        |
+ *
+ * Stages are connected by SpscQueue of batch pointers. Batches are allocated in Pool at construction,
+ * acquired by the producing stage and released by the consuming stage, so no memory is allocated while running.
+ * A slow handler blocks only dispatch stage, until all batches are queued.
+ * Each stage can be pinned to a core on Linux, the stage thread pins itself before it processes anything.
+ *
+ * A stage waiting for a queue spins a few times, and then sleeps on a condition variable
+ * until the other stage notifies it, so an idle pipeline doesn't use cores.
+ * When reader returns 0, ingest stage sleeps from `MIN_SLEEP` growing up to `MAX_SLEEP`,
+ * so reader should block for a while ( ex. `poll()` with timeout ) instead of returning 0 at once,
+ * to avoid this latency.
+ *
+ * stop() waits for reader to return. If reader may block for long, pass a waker which makes it return,
+ * ex. writes to a self pipe polled by reader, or `shutdown()` of the socket.
+ */
+
+#ifndef SimpleControlSerialized_ReceivePipeline_h
+#define SimpleControlSerialized_ReceivePipeline_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Parser.hpp"
+#include "SimpleControl_Pool.hpp"
+#include "SimpleControl_SpscQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#if defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides 3 stages receive pipeline
+   */
+  class Serialized_ReceivePipeline {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      /**
+       * @brief reader of ingest stage
+       *
+       * fill octets into buffer and return number of octets, 0 if nothing is available.
+       * reader should return in a while, or return after waker is called, to stop the pipeline.
+       */
+      using Reader  = std :: function< size_type( value_type* buffer, size_type capacity ) >;
+
+      /**
+       * @brief handler of dispatch stage, called with a batch of decoded messages
+       */
+      using Handler = std :: function< void( const Message* messages, size_type count ) >;
+
+      /**
+       * @brief waker of reader, called by stop() to make blocking reader return
+       */
+      using Waker   = std :: function< void( void ) >;
+
+      /**
+       * @brief stages of pipeline
+       */
+      enum Stage {
+          INGEST   ///< reads octets
+        , PARSE    ///< decodes octets into messages
+        , DISPATCH ///< calls handler
+        , STAGES   ///< number of stages
+      };
+
+      constexpr static size_type OCTET_BATCH   = 4096; ///< octets per batch
+      constexpr static size_type MESSAGE_BATCH = 1024; ///< messages per batch
+      constexpr static size_type DEPTH         = 16;   ///< batches between 2 stages
+
+      constexpr static size_type SPIN      = 64;   ///< yields before a stage sleeps
+      constexpr static unsigned  MIN_SLEEP = 16;   ///< first sleep of ingest stage in microseconds, when reader returns 0
+      constexpr static unsigned  MAX_SLEEP = 1000; ///< maximum sleep of ingest stage in microseconds, when reader returns 0
+
+    private:
+
+      /**
+       * @brief event count, a stage sleeps on it until other stages notify
+       *
+       * take a key by prepare() before checking a queue, and wait( key ) if the queue is not ready.
+       * notify() after the queue is changed, wait() returns when notify() is called after prepare().
+       */
+      struct Signal {
+        std :: atomic< std :: uint32_t > epoch;     ///< incremented by notify()
+        std :: atomic< std :: uint32_t > waiters;   ///< number of sleeping threads
+        std :: mutex                     mutex;     ///< guard of condition
+        std :: condition_variable        condition; ///< sleeping threads
+
+        Signal( void ) : epoch( 0 ), waiters( 0 ), mutex(), condition() {}
+
+        std :: uint32_t prepare( void ) const { return epoch.load( std :: memory_order_acquire ); }
+
+        void wait( const std :: uint32_t key ){
+
+          for( size_type i = 0 ; i < SPIN ; ++ i ){
+            if( epoch.load( std :: memory_order_acquire ) != key )
+              return;
+            std :: this_thread :: yield();
+          }
+
+          std :: unique_lock< std :: mutex > lock( mutex );
+          waiters.fetch_add( 1, std :: memory_order_seq_cst );
+          condition.wait( lock, [ & ]{ return epoch.load( std :: memory_order_seq_cst ) != key; } );
+          waiters.fetch_sub( 1, std :: memory_order_relaxed );
+        }
+
+        void notify( void ){
+          epoch.fetch_add( 1, std :: memory_order_seq_cst );
+          if( waiters.load( std :: memory_order_seq_cst ) != 0 ){
+            std :: lock_guard< std :: mutex > lock( mutex );
+            condition.notify_all();
+          }
+        }
+      };
+
+      /**
+       * @brief batch of received octets
+       */
+      struct OctetBatch {
+        value_type data[ OCTET_BATCH ]; ///< octets
+        size_type  size;                ///< number of valid octets
+
+        OctetBatch( void ) : size( 0 ) {} ///< data is not initialized
+      };
+
+      /**
+       * @brief batch of decoded messages
+       */
+      struct MessageBatch {
+        Message   data[ MESSAGE_BATCH ]; ///< messages
+        size_type size;                  ///< number of valid messages
+
+        MessageBatch( void ) : size( 0 ) {} ///< data is not initialized
+      };
+
+      constexpr static size_type CACHE = 4; ///< batches cached per thread in Pool
+
+      Reader  _reader;  ///< reader of ingest stage
+      Handler _handler; ///< handler of dispatch stage
+      Waker   _waker;   ///< waker of reader, may be empty
+
+      Pool< OctetBatch,   CACHE > _octet_batches;   ///< octet batches, acquired by ingest and released by parse
+      Pool< MessageBatch, CACHE > _message_batches; ///< message batches, acquired by parse and released by dispatch
+
+      SpscQueue< OctetBatch*,   DEPTH > _octets_full;    ///< ingest -> parse
+      SpscQueue< MessageBatch*, DEPTH > _messages_full;  ///< parse -> dispatch
+
+      std :: thread        _threads[ STAGES ]; ///< stage threads
+      int                  _cores  [ STAGES ]; ///< pinned core of each stage, -1 for not pinned
+      Signal               _signals[ STAGES ]; ///< wakes sleeping stage
+      std :: atomic< bool > _running;          ///< true while stages run
+
+      std :: atomic< std :: uint64_t > _octets;   ///< number of read octets
+      std :: atomic< std :: uint64_t > _messages; ///< number of dispatched messages
+      std :: atomic< std :: uint64_t > _invalid;  ///< number of discarded frames
+
+    public:
+
+      /**
+       * @brief constructor, allocates all batches
+       *
+       * @param[in] reader    reader of ingest stage
+       * @param[in] handler   handler of dispatch stage
+       * @param[in] waker     called by stop() to make blocking reader return, empty if reader returns in a while
+       */
+      Serialized_ReceivePipeline( Reader reader, Handler handler, Waker waker = Waker() ) :
+          _reader( std :: move( reader ) )
+        , _handler( std :: move( handler ) )
+        , _waker( std :: move( waker ) )
+        , _octet_batches( DEPTH )
+        , _message_batches( DEPTH )
+        , _octets_full()
+        , _messages_full()
+        , _threads()
+        , _cores{ -1, -1, -1 }
+        , _signals()
+        , _running( false )
+        , _octets( 0 )
+        , _messages( 0 )
+        , _invalid( 0 )
+      {}
+
+      /**
+       * @brief destructor, stops stages
+       */
+      ~Serialized_ReceivePipeline( void ){ stop(); }
+
+      Serialized_ReceivePipeline( const Serialized_ReceivePipeline& ) = delete;
+      Serialized_ReceivePipeline& operator= ( const Serialized_ReceivePipeline& ) = delete;
+
+
+      /**
+       * @brief pin a stage to a core, applied by the stage thread at start()
+       *
+       * @param[in] stage   stage to pin
+       * @param[in] core    index of core, -1 for not pinned
+       * @return            false if pinning is not supported on this platform
+       */
+      bool pin( const Stage stage, const int core ){
+        if( stage >= STAGES )
+          return false;
+        _cores[ stage ] = core;
+#if defined( __linux__ )
+        return true;
+#else
+        return core < 0;
+#endif
+      }
+
+
+      /**
+       * @brief start stage threads
+       */
+      void start( void ){
+
+        if( _running.exchange( true ) )
+          return;
+
+        _threads[ INGEST   ] = std :: thread( &Serialized_ReceivePipeline :: ingest,   this );
+        _threads[ PARSE    ] = std :: thread( &Serialized_ReceivePipeline :: parse,    this );
+        _threads[ DISPATCH ] = std :: thread( &Serialized_ReceivePipeline :: dispatch, this );
+      }
+
+      /**
+       * @brief stop stage threads
+       *
+       * octets and messages still in the pipeline are dispatched before stop, and all batches are returned,
+       * so the pipeline can be started again.
+       *
+       * @note this function waits for reader to return, waker is called to make it return
+       */
+      void stop( void ){
+
+        if( ! _running.exchange( false ) )
+          return;
+
+        if( _waker )
+          _waker();
+        _signals[ INGEST ].notify();
+
+        for( std :: thread& thread : _threads )
+          thread.join();
+      }
+
+
+      std :: uint64_t octets  ( void ) const { return _octets  .load( std :: memory_order_relaxed ); } ///< number of read octets
+      std :: uint64_t messages( void ) const { return _messages.load( std :: memory_order_relaxed ); } ///< number of dispatched messages
+      std :: uint64_t invalid ( void ) const { return _invalid .load( std :: memory_order_relaxed ); } ///< number of discarded frames
+
+
+    private:
+
+      /**
+       * @brief pin the calling stage thread to its core
+       *
+       * @param[in] stage   stage of the calling thread
+       */
+      void pin_self( const Stage stage ){
+#if defined( __linux__ )
+        if( _cores[ stage ] < 0 )
+          return;
+        cpu_set_t set;
+        CPU_ZERO( &set );
+        CPU_SET( _cores[ stage ], &set );
+        pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );
+#else
+        (void)stage;
+#endif
+      }
+
+      /**
+       * @brief push a batch, sleep while the queue is full
+       *
+       * @param[in] queue   queue to push
+       * @param[in] batch   batch to push
+       * @param[in] self    stage of the calling thread, woken when the queue is popped
+       * @param[in] next    stage popping the queue, notified after push
+       */
+      template < typename Queue, typename Batch >
+      void push( Queue& queue, Batch* batch, const Stage self, const Stage next ){
+        for( ;; ){
+          const std :: uint32_t key = _signals[ self ].prepare();
+          if( queue.push( batch ) )
+            break;
+          _signals[ self ].wait( key );
+        }
+        _signals[ next ].notify();
+      }
+
+      /**
+       * @brief pop a batch, sleep while the queue is empty
+       *
+       * @param[in] queue   queue to pop
+       * @param[in] self    stage of the calling thread, woken when the queue is pushed
+       * @param[in] last    stage pushing the queue, notified after pop
+       * @return            popped batch
+       */
+      template < typename Batch, typename Queue >
+      Batch* pop( Queue& queue, const Stage self, const Stage last ){
+        Batch* batch;
+        for( ;; ){
+          const std :: uint32_t key = _signals[ self ].prepare();
+          if( queue.pop( batch ) )
+            break;
+          _signals[ self ].wait( key );
+        }
+        _signals[ last ].notify();
+        return batch;
+      }
+
+
+      /**
+       * @brief acquire a batch, sleep while all batches are in use
+       *
+       * @param[in] pool    pool of batches
+       * @param[in] self    stage of the calling thread, woken when a batch is released
+       * @return            acquired batch
+       */
+      template < typename Batch >
+      Batch* acquire( Pool< Batch, CACHE >& pool, const Stage self ){
+        for( ;; ){
+          const std :: uint32_t key   = _signals[ self ].prepare();
+          Batch*                batch = pool.acquire();
+          if( batch != nullptr )
+            return batch;
+          _signals[ self ].wait( key );
+        }
+      }
+
+
+      /**
+       * @brief loop of ingest stage
+       */
+      void ingest( void ){
+
+        pin_self( INGEST );
+
+        OctetBatch* batch = nullptr;
+        unsigned    sleep = 0;
+
+        while( _running.load( std :: memory_order_relaxed ) ){
+
+          if( batch == nullptr ){
+            const std :: uint32_t key = _signals[ INGEST ].prepare();
+            batch = _octet_batches.acquire();
+            if( batch == nullptr ){
+              if( _running.load( std :: memory_order_relaxed ) )
+                _signals[ INGEST ].wait( key );
+              continue;
+            }
+          }
+
+          batch -> size = _reader( batch -> data, OCTET_BATCH );
+          if( batch -> size == 0 ){
+            sleep = sleep == 0 ? MIN_SLEEP : sleep * 2 > MAX_SLEEP ? MAX_SLEEP : sleep * 2;
+            std :: this_thread :: sleep_for( std :: chrono :: microseconds( sleep ) );
+            continue;
+          }
+          sleep = 0;
+
+          _octets.fetch_add( batch -> size, std :: memory_order_relaxed );
+
+          push( _octets_full, batch, INGEST, PARSE );
+          batch = nullptr;
+        }
+
+        if( batch != nullptr )
+          _octet_batches.release( batch );
+
+        push( _octets_full, static_cast< OctetBatch* >( nullptr ), INGEST, PARSE );
+      }
+
+
+      /**
+       * @brief loop of parse stage, stops when ingest stage sends null batch
+       */
+      void parse( void ){
+
+        pin_self( PARSE );
+
+        Serialized_Parser parser;
+        MessageBatch*     messages = nullptr;
+
+        for( ;; ){
+
+          OctetBatch* octets = pop< OctetBatch >( _octets_full, PARSE, INGEST );
+
+          if( octets == nullptr )
+            break;
+
+          for( size_type offset = 0 ; offset < octets -> size ; ){
+
+            if( messages == nullptr )
+              messages = acquire( _message_batches, PARSE );
+
+            size_type count;
+            offset += parser.parse(
+                  octets -> data + offset
+                , octets -> size - offset
+                , messages -> data + messages -> size
+                , MESSAGE_BATCH - messages -> size
+                , count );
+            messages -> size += count;
+
+            if( messages -> size == MESSAGE_BATCH ){
+              push( _messages_full, messages, PARSE, DISPATCH );
+              messages = nullptr;
+            }
+          }
+
+          _octet_batches.release( octets );
+          _signals[ INGEST ].notify();
+
+          if( messages != nullptr && messages -> size != 0 && _octets_full.empty() ){
+            push( _messages_full, messages, PARSE, DISPATCH );
+            messages = nullptr;
+          }
+
+          _invalid.store( parser.invalid(), std :: memory_order_relaxed );
+        }
+
+        if( messages != nullptr && messages -> size != 0 )
+          push( _messages_full, messages, PARSE, DISPATCH );
+        else
+          _message_batches.release( messages );
+
+        push( _messages_full, static_cast< MessageBatch* >( nullptr ), PARSE, DISPATCH );
+      }
+
+
+      /**
+       * @brief loop of dispatch stage, stops when parse stage sends null batch
+       */
+      void dispatch( void ){
+
+        pin_self( DISPATCH );
+
+        for( ;; ){
+
+          MessageBatch* batch = pop< MessageBatch >( _messages_full, DISPATCH, PARSE );
+
+          if( batch == nullptr )
+            break;
+
+          _handler( batch -> data, batch -> size );
+          _messages.fetch_add( batch -> size, std :: memory_order_relaxed );
+
+          _message_batches.release( batch );
+          _signals[ PARSE ].notify();
+        }
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_ReceivePipeline_h */
@@ -0,0 +1,362 @@
+/**
+ *  @file           Serialized_Router.hpp
+ *  @brief          This class provides zero copy router, to fan out received octets to outputs by Address range rules, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Rules `[ low, high ] -> output` are compiled into a sorted table of elementary intervals ( see Intervals ),
+ * each interval has a bit mask of outputs. An Address is looked up by branchless binary search.
+ *
+ * Received octets are never decoded except Address frames, and never encoded again.
+ * Each Address frame and following Data class octets are routed to outputs of the Address,
+ * as slices of the received buffer. Slices share the buffer by reference count,
+ * and contiguous octets for an output are passed as one slice.
+ * Data class octets after an interrupted Address frame are not routed, until next whole Address frame.
+ *
+ * Integrity frames ( `KIND_CHECK` ), version markers ( `KIND_SYNC` ) and credit frames ( `KIND_CREDIT` ) are not routed,
+ * they are valid only on the input link.
+ */
+
+#ifndef SimpleControlSerialized_Router_h
+#define SimpleControlSerialized_Router_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "SimpleControl_Intervals.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides router of serial octets by Address range
+   *
+   * @note this class is not thread safe, sinks are called on the thread of route()
+   */
+  class Serialized_Router {
+
+    public:
+      using value_type = Serialized :: value_type;  ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;   ///< serial data size type, same as Serialized
+      using Buffer     = std :: vector< value_type >; ///< received octets
+
+      constexpr static size_type MAX_OUTPUTS = 64; ///< maximum number of outputs
+
+      /**
+       * @brief octets routed to an output
+       *
+       * `prefix` is the head of a frame split by previous buffer, send it before `buffer` octets.
+       * copy a slice to keep the buffer alive, ex. for asynchronous write.
+       */
+      struct Slice {
+        std :: shared_ptr< const Buffer > buffer;                   ///< received buffer
+        size_type                         offset;                   ///< first octet in buffer
+        size_type                         length;                   ///< number of octets in buffer
+        value_type                        prefix[ Serialized :: SIZE ]; ///< octets sent before buffer octets
+        size_type                         prefix_size;              ///< number of prefix octets
+
+        const value_type* begin( void ) const { return buffer -> data() + offset; }          ///< first octet in buffer
+        const value_type* end  ( void ) const { return buffer -> data() + offset + length; } ///< end of octets in buffer
+      };
+
+      /**
+       * @brief output of routed slices
+       */
+      using Sink = std :: function< void( const Slice& slice ) >;
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+
+      /**
+       * @brief a rule
+       */
+      struct Rule {
+        Address   low;    ///< first Address
+        Address   high;   ///< last Address
+        size_type output; ///< index of output
+      };
+
+      /**
+       * @brief slice being extended for an output
+       */
+      struct Open {
+        Slice slice;  ///< slice
+        bool  active; ///< true if slice has octets
+      };
+
+      std :: vector< Sink > _sinks; ///< outputs
+      std :: vector< Rule > _rules; ///< rules
+      std :: vector< Open > _open;  ///< open slices of outputs
+
+      Intervals                        _intervals; ///< elementary intervals of rules
+      std :: vector< std :: uint64_t > _masks;     ///< outputs of elementary intervals
+      bool                             _dirty;     ///< true if rules are changed after build
+
+      Serialized     _frame;   ///< collecting Address class frame
+      size_type      _count;   ///< number of collected octets
+      std :: uint64_t _mask;   ///< outputs of current Address
+      Address        _address; ///< last looked up Address
+      bool           _cached;  ///< true if _address is valid
+
+      std :: uint64_t _routed;  ///< number of routed Address frames
+      std :: uint64_t _invalid; ///< number of discarded frames
+
+    public:
+
+      /**
+       * @brief default constructor, no outputs and no rules
+       */
+      Serialized_Router( void ) :
+          _sinks()
+        , _rules()
+        , _open()
+        , _intervals()
+        , _masks( 1, 0 )
+        , _dirty( false )
+        , _frame()
+        , _count( 0 )
+        , _mask( 0 )
+        , _address( 0 )
+        , _cached( false )
+        , _routed( 0 )
+        , _invalid( 0 )
+      {}
+
+
+      std :: uint64_t routed ( void ) const { return _routed;  } ///< number of routed Address frames
+      std :: uint64_t invalid( void ) const { return _invalid; } ///< number of discarded frames
+
+
+      /**
+       * @brief add an output
+       *
+       * @param[in] sink  called with slices for this output
+       * @return          index of output, `MAX_OUTPUTS` if outputs are full
+       */
+      size_type add_output( Sink sink ){
+        if( _sinks.size() == MAX_OUTPUTS )
+          return MAX_OUTPUTS;
+        _sinks.push_back( std :: move( sink ) );
+        _open .push_back( Open() );
+        return _sinks.size() - 1;
+      }
+
+      /**
+       * @brief add a rule, Addresses in `[ low, high ]` are routed to output
+       *
+       * @param[in] low     first Address
+       * @param[in] high    last Address
+       * @param[in] output  index of output
+       * @return            false if output is not added or low is over high
+       */
+      bool add_rule( const Address& low, const Address& high, const size_type output ){
+        if( output >= _sinks.size() || low > high )
+          return false;
+        _rules.push_back( Rule{ low, high, output } );
+        _dirty = true;
+        return true;
+      }
+
+      /**
+       * @brief remove all rules
+       */
+      void clear_rules( void ){
+        _rules.clear();
+        _dirty = true;
+      }
+
+
+      /**
+       * @brief outputs of an Address
+       *
+       * @param[in] address   Address to look up
+       * @return              bit mask of outputs, bit i is output i
+       */
+      std :: uint64_t lookup( const Address& address ){
+
+        if( _dirty )
+          build();
+
+        return _masks[ _intervals.find( address ) ];
+      }
+
+
+      /**
+       * @brief route received octets
+       *
+       * buffers are routed in order of receive, a frame can be split between buffers.
+       * slices of each output are passed to its sink before this function returns.
+       *
+       * @param[in] buffer  received octets
+       */
+      void route( const std :: shared_ptr< const Buffer >& buffer ){
+
+        if( _dirty )
+          build();
+
+        const value_type* input  = buffer -> data();
+        const size_type   length = buffer -> size();
+
+        size_type i = 0;
+
+        while( i < length ){
+
+          if( (input[ i ] & header_bit) == 0 ){
+
+            if( _count != 0 ){
+              _count  = 0;
+              _mask   = 0;
+              _cached = false;
+              ++ _invalid;
+            }
+
+            size_type end = i + 1;
+            while( end < length && (input[ end ] & header_bit) == 0 )
+              ++ end;
+
+            emit( buffer, i, end, _mask );
+            i = end;
+            continue;
+          }
+
+          if( _count == 0 && length - i >= Serialized :: SIZE
+              && (input[ i ] & input[ i + 1 ] & input[ i + 2 ] & input[ i + 3 ] & input[ i + 4 ] & header_bit) != 0 ){
+            i += Serialized :: SIZE;
+            address_frame( input + i - Serialized :: SIZE, buffer, i );
+            continue;
+          }
+
+          _frame[ _count ++ ] = input[ i ++ ];
+          if( _count < Serialized :: SIZE )
+            continue;
+
+          _count = 0;
+          address_frame( &_frame[ 0 ], buffer, i );
+        }
+
+        for( size_type output = 0 ; output < _open.size() ; ++ output ){
+          flush( output );
+          _open[ output ].slice.buffer.reset();
+        }
+      }
+
+
+    private:
+
+      /**
+       * @brief compile rules into elementary intervals
+       */
+      void build( void ){
+
+        _intervals.clear();
+        for( const Rule& rule : _rules )
+          _intervals.add( rule.low, rule.high );
+        _intervals.sort();
+
+        _masks.assign( _intervals.size(), 0 );
+        for( const Rule& rule : _rules )
+          for( size_type index = _intervals.first( rule.low ), end = _intervals.end( rule.high ) ; index < end ; ++ index )
+            _masks[ index ] |= static_cast< std :: uint64_t >( 1 ) << rule.output;
+
+        _dirty  = false;
+        _cached = false;
+      }
+
+
+      /**
+       * @brief look up outputs of an Address class frame, and pass the frame to them
+       *
+       * @param[in] frame   octets of the frame
+       * @param[in] buffer  received buffer
+       * @param[in] end     end of the frame in buffer, the frame may start in previous buffer
+       */
+      void address_frame( const value_type* frame, const std :: shared_ptr< const Buffer >& buffer, const size_type end ){
+
+        const value_type kind = frame[ Serialized :: SIZE - 1 ] & Serialized :: KIND_MASK;
+        if( kind == Serialized :: KIND_CHECK || kind == Serialized :: KIND_SYNC || kind == Serialized :: KIND_CREDIT )
+          return;
+
+        const Address address = static_cast< Address >(
+              static_cast< Address >( frame[ 0 ] & 0x7F )
+            | static_cast< Address >( frame[ 1 ] & 0x7F ) << 7
+            | static_cast< Address >( frame[ 2 ] & 0x7F ) << 14
+            | static_cast< Address >( frame[ 3 ] & 0x7F ) << 21
+            | static_cast< Address >( frame[ 4 ] & 0x0F ) << 28 );
+
+        if( ! _cached || address != _address ){
+          _address = address;
+          _mask    = lookup( address );
+          _cached  = true;
+        }
+
+        ++ _routed;
+        emit( buffer, end, end, _mask, Serialized :: SIZE );
+      }
+
+      /**
+       * @brief pass octets to outputs of mask
+       *
+       * @param[in] buffer  received buffer
+       * @param[in] begin   first octet in buffer
+       * @param[in] end     end of octets in buffer
+       * @param[in] mask    outputs
+       * @param[in] frame   octets of Address frame just before begin, 0 for none.
+       *                    octets before start of buffer are taken from _frame
+       */
+      void emit( const std :: shared_ptr< const Buffer >& buffer, size_type begin, const size_type end, std :: uint64_t mask, const size_type frame = 0 ){
+
+        size_type prefix = 0;
+        if( frame > begin ){
+          prefix = frame - begin;
+          begin  = 0;
+        }
+        else
+          begin -= frame;
+
+        for( ; mask != 0 ; mask &= mask - 1 ){
+
+          const size_type output = static_cast< size_type >( __builtin_ctzll( mask ) );
+          Open&           open   = _open[ output ];
+
+          if( open.active && prefix == 0 && open.slice.offset + open.slice.length == begin ){
+            open.slice.length = end - open.slice.offset;
+            continue;
+          }
+
+          flush( output );
+
+          open.active            = true;
+          if( open.slice.buffer != buffer )
+            open.slice.buffer = buffer;
+          open.slice.offset      = begin;
+          open.slice.length      = end - begin;
+          open.slice.prefix_size = prefix;
+          for( size_type k = 0 ; k < prefix ; ++ k )
+            open.slice.prefix[ k ] = _frame[ k ];
+        }
+      }
+
+      /**
+       * @brief pass open slice to sink of output
+       */
+      void flush( const size_type output ){
+
+        Open& open = _open[ output ];
+        if( ! open.active )
+          return;
+
+        _sinks[ output ]( open.slice );
+        open.active = false;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_Router_h */
@@ -0,0 +1,117 @@
+/**
+ *  @file           Serialized_RunningStatus.hpp
+ *  @brief          This class provides running status sender, to omit Address frames repeated with same value.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Like MIDI running status, Address frame is omitted when a message has same Address as previous one.
+ * Receiver decodes following Data frames with last Address, see Serialized_Parser.
+ * Address frame is sent again every `refresh` messages, so a receiver which lost the Address frame
+ * or started in the middle of the stream recovers in a while.
+ */
+
+#ifndef SimpleControlSerialized_RunningStatus_h
+#define SimpleControlSerialized_RunningStatus_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides encoder of messages with running status
+   */
+  class Serialized_RunningStatus {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static size_type MAX_SIZE = Serialized :: SIZE * 2; ///< maximum octets of an encoded message
+
+    private:
+      Serialized _address_frame; ///< encoded last Address
+      Address    _address;       ///< last sent Address
+      bool       _has_address;   ///< true if _address was sent
+      size_type  _refresh;       ///< interval of Address refresh in messages
+      size_type  _count;         ///< messages after last Address frame
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] refresh   Address frame is sent at least once per this number of messages, 1 disables running status
+       */
+      Serialized_RunningStatus( const size_type refresh = 16 ) :
+          _address_frame()
+        , _address( 0 )
+        , _has_address( false )
+        , _refresh( refresh == 0 ? 1 : refresh )
+        , _count( 0 )
+      {}
+
+
+      /**
+       * @brief send Address frame with next message
+       *
+       * call this function after other frames are sent on the same link ( ex. Serialized_Bulk ),
+       * or after the receiver was reset.
+       */
+      void reset( void ){ _has_address = false; }
+
+
+      /**
+       * @brief encode a message
+       *
+       * @param[in]   address   Address of message
+       * @param[in]   data      Data of message
+       * @param[out]  output    start of serialized data, requires `MAX_SIZE` octets
+       * @return                octets written to output, `Serialized :: SIZE` if Address frame is omitted
+       */
+      size_type encode( const Address& address, const Data& data, value_type* output ){
+
+        size_type length = 0;
+
+        if( ! _has_address || address != _address || _count >= _refresh ){
+
+          if( ! _has_address || address != _address ){
+            _address_frame.encode( address );
+            _address     = address;
+            _has_address = true;
+          }
+
+          for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i )
+            output[ length ++ ] = _address_frame[ i ];
+
+          _count = 0;
+        }
+
+        Serialized frame( data );
+        for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i )
+          output[ length ++ ] = frame[ i ];
+
+        ++ _count;
+
+        return length;
+      }
+
+      /**
+       * @brief encode a message
+       *
+       * @param[in]   message   Address and Data of message
+       * @param[out]  output    start of serialized data, requires `MAX_SIZE` octets
+       * @return                octets written to output
+       */
+      size_type encode( const Message& message, value_type* output ){
+        return encode( message.address, message.data, output );
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_RunningStatus_h */
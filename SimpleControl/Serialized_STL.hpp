@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <algorithm>
 #include <array> 
+#include <stdexcept>
 
 
 namespace SimpleControl{ 
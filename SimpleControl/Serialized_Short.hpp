@@ -0,0 +1,315 @@
+/**
+ *  @file           Serialized_Short.hpp
+ *  @brief          This class provides variable length Address frame, for links which use small Address values.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Short Address frame is LEB128 like encoding inside 7 bit octets.
+ *
+ * | bit      | contents                                         |
+ * | -------- | ------------------------------------------------ |
+ * | `0b1*******` | header bit, same as fixed Address frame      |
+ * | `0b*1******` | continue bit, next octet is also this Address |
+ * | `0b**111111` | 6 bit of Address value, lower bits first     |
+ *
+ * | Address value | octets |
+ * | ------------- | ------ |
+ * | 0 - 2^6  - 1  | 1      |
+ * | 0 - 2^12 - 1  | 2      |
+ * | 0 - 2^18 - 1  | 3      |
+ * | 0 - 2^24 - 1  | 4      |
+ * | 0 - 2^30 - 1  | 5      |
+ * | 0 - 2^32 - 1  | 6      |
+ *
+ * Short Address frame can't be distinguished from fixed Address frame by octets,
+ * so both sides of a link have to choose short or fixed Address frame.
+ * Data frames are same as fixed Address frame link.
+ *
+ * A short link carries Address and Data frames only, Serialized_ShortParser decodes them from a stream.
+ * Frames of other kinds and classes for fixed links, ex. Serialized_Parser, Serialized_RunningStatus, Serialized_Router,
+ * Serialized_IntegrityChecker, Serialized_Bulk and quantized frames, assume 5 octets Address frames and can't be used on a short link.
+ * Running status is still available, the sender omits Address frame of same Address as previous message.
+ */
+
+#ifndef SimpleControlSerialized_Short_h
+#define SimpleControlSerialized_Short_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides encode/decode functions of variable length Address frame
+   */
+  class Serialized_Short {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static size_type MAX_SIZE = 6; ///< maximum octets of short Address frame
+
+    private:
+      constexpr static value_type header_bit   = 0b10000000;
+      constexpr static value_type continue_bit = 0b01000000;
+      constexpr static value_type value_bits   = 0b00111111;
+
+    public:
+
+      /**
+       * @brief octets of short Address frame
+       *
+       * @param[in] address   Address value
+       * @return              1 - `MAX_SIZE`
+       */
+      static size_type size( const Address& address ){
+        return 1
+          + (address >= (static_cast< Address >( 1 ) <<  6))
+          + (address >= (static_cast< Address >( 1 ) << 12))
+          + (address >= (static_cast< Address >( 1 ) << 18))
+          + (address >= (static_cast< Address >( 1 ) << 24))
+          + (address >= (static_cast< Address >( 1 ) << 30));
+      }
+
+
+      /**
+       * @brief encode Address to short Address frame
+       *
+       * @param[in]   address   original Address
+       * @param[out]  output    start of serialized data, requires size( const Address& address ) octets
+       * @return                octets written to output
+       */
+      static size_type encode( const Address& address, value_type* output ){
+
+        Address   rest   = address;
+        size_type length = 0;
+
+        while( rest > value_bits ){
+          output[ length ++ ] = static_cast< value_type >( header_bit | continue_bit | (rest & value_bits) );
+          rest >>= 6;
+        }
+        output[ length ++ ] = static_cast< value_type >( header_bit | rest );
+
+        return length;
+      }
+
+
+      /**
+       * @brief decode short Address frame to Address
+       *
+       * Address frames up to 3 octets are decoded with one branch, when 3 octets are readable.
+       *
+       * @param[in]   input     start of short Address frame
+       * @param[in]   length    readable octets of input
+       * @param[out]  output    decoded Address
+       * @return                octets of decoded frame, 0 if input is truncated or malformed
+       */
+      static size_type decode( const value_type* input, const size_type length, Address& output ){
+
+        if( length >= 3 ){
+          const Address o0 = input[ 0 ];
+          const Address o1 = input[ 1 ];
+          const Address o2 = input[ 2 ];
+
+          const Address c0 =      (o0 >> 6) & 1;
+          const Address c1 = c0 & (o1 >> 6);
+          const Address c2 = c1 & (o2 >> 6);
+
+          const Address header = (o0 >> 7) & ((o1 >> 7) | (c0 ^ 1)) & ((o2 >> 7) | (c1 ^ 1));
+
+          if( (c2 | (header ^ 1)) == 0 ){
+            output =  (o0 & value_bits)
+                   | ((o1 & value_bits) <<  6 & (0 - c0))
+                   | ((o2 & value_bits) << 12 & (0 - c1));
+            return 1 + c0 + c1;
+          }
+        }
+
+        Address result = 0;
+
+        for( size_type i = 0 ; i < MAX_SIZE && i < length ; ++ i ){
+
+          const value_type octet = input[ i ];
+          if( (octet & header_bit) == 0 )
+            return 0;
+
+          result |= static_cast< Address >( octet & value_bits ) << (6 * i);
+
+          if( (octet & continue_bit) == 0 ){
+            output = result;
+            return i + 1;
+          }
+        }
+
+        return 0;
+      }
+
+  };
+
+
+
+  /**
+   * @brief this class provides stream parser of short Address frames and Data frames
+   *
+   * Parser keeps last decoded Address, and each Data frame makes a message with it, same as Serialized_Parser.
+   * A frame interrupted by other class octet is discarded. After an interrupted Address frame,
+   * Data class octets are skipped until next Address class octet, because they belong to the lost Address.
+   */
+  class Serialized_ShortParser {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+      constexpr static value_type header_bit   = 0b10000000;
+      constexpr static value_type continue_bit = 0b01000000;
+      constexpr static value_type value_bits   = 0b00111111;
+
+      Serialized _frame;       ///< collecting Data frame
+      size_type  _count;       ///< number of collected octets in _frame
+      Address    _collecting;  ///< collecting Address value
+      size_type  _position;    ///< number of collected octets of short Address frame
+      Address    _address;     ///< last decoded Address
+      bool       _has_address; ///< true if _address is available
+      bool       _skip;        ///< true while skipping Data class octets after interrupted Address frame
+      size_type  _invalid;     ///< number of discarded frames
+
+    public:
+
+      /**
+       * @brief default constructor
+       */
+      Serialized_ShortParser( void ) :
+          _frame()
+        , _count( 0 )
+        , _collecting( 0 )
+        , _position( 0 )
+        , _address( 0 )
+        , _has_address( false )
+        , _skip( false )
+        , _invalid( 0 )
+      {}
+
+
+      /**
+       * @brief discard collecting frame and last Address
+       */
+      void reset( void ){
+        _count       = 0;
+        _collecting  = 0;
+        _position    = 0;
+        _has_address = false;
+        _skip        = false;
+      }
+
+
+      bool           has_address( void ) const { return _has_address; } ///< true if an Address frame was decoded after reset
+      const Address& address    ( void ) const { return _address; }     ///< last decoded Address, available when has_address() is true
+
+      /**
+       * @brief number of discarded frames
+       *
+       * counted interrupted frames, Address frames over MAX_SIZE, Data frames with padding bits and Data frames without Address
+       */
+      size_type invalid( void ) const { return _invalid; }
+
+
+      /**
+       * @brief parse an octet
+       *
+       * @param[in]   octet     received octet
+       * @param[out]  message   decoded message, written only when this function returns true
+       * @return                true if a Data frame is completed and message is decoded
+       */
+      bool parse( const value_type octet, Message& message ){
+
+        if( (octet & header_bit) != 0 ){
+
+          _skip = false;
+          if( _count != 0 ){
+            _count = 0;
+            ++ _invalid;
+          }
+
+          _collecting |= static_cast< Address >( octet & value_bits ) << (6 * _position);
+          ++ _position;
+
+          if( (octet & continue_bit) == 0 ){
+            _address     = _collecting;
+            _has_address = true;
+            _collecting  = 0;
+            _position    = 0;
+          }
+          else if( _position == Serialized_Short :: MAX_SIZE ){
+            _collecting  = 0;
+            _position    = 0;
+            _has_address = false;
+            _skip        = true;
+            ++ _invalid;
+          }
+          return false;
+        }
+
+        if( _position != 0 ){
+          _collecting  = 0;
+          _position    = 0;
+          _has_address = false;
+          _skip        = true;
+          ++ _invalid;
+        }
+
+        if( _skip )
+          return false;
+
+        _frame[ _count ++ ] = octet;
+
+        if( _count < Serialized :: SIZE )
+          return false;
+
+        _count = 0;
+
+        if( ! _frame.is_data() || ! _has_address ){
+          ++ _invalid;
+          return false;
+        }
+
+        message.address = _address;
+        _frame.decode( message.data );
+        return true;
+      }
+
+
+      /**
+       * @brief parse octets
+       *
+       * parsing stops when output is full or input is finished.
+       *
+       * @param[in]   input     start of received octets
+       * @param[in]   length    number of received octets
+       * @param[out]  output    start of message array
+       * @param[in]   capacity  number of messages output can store
+       * @param[out]  count     number of decoded messages
+       * @return                number of parsed octets
+       */
+      size_type parse( const value_type* input, const size_type length, Message* output, const size_type capacity, size_type& count ){
+
+        count = 0;
+
+        size_type i = 0;
+        while( i < length && count < capacity )
+          if( parse( input[ i ++ ], output[ count ] ) )
+            ++ count;
+
+        return i;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_Short_h */
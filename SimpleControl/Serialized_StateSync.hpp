@@ -0,0 +1,420 @@
+/**
+ *  @file           Serialized_StateSync.hpp
+ *  @brief          This class provides versioned parameter store, full snapshot and incremental diff for late joining receivers, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * ParameterStore keeps current Data of each Address, sorted by Address, with the version of its last change.
+ * `snapshot()` encodes all parameters, `diff( since )` encodes parameters changed after version `since`.
+ *
+ * | parameters                       | encoded as                                   |
+ * | -------------------------------- | -------------------------------------------- |
+ * | 2 or more consecutive Addresses  | Serialized_Bulk frame                        |
+ * | single Address                   | Address frame + Data frame                   |
+ * | end of snapshot / diff           | version marker, Address frame of `KIND_SYNC` |
+ *
+ * Serialized_StateReceiver decodes them and calls handler with batches of messages.
+ * After reconnection, receiver asks sender for `diff( receiver.version() )`, or a snapshot if it has no state.
+ */
+
+#ifndef SimpleControlSerialized_StateSync_h
+#define SimpleControlSerialized_StateSync_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Bulk.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides sender side parameter store with versions
+   *
+   * @note this class is not thread safe, diff() and snapshot() also reuse a member buffer
+   */
+  class ParameterStore {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+
+      /**
+       * @brief a parameter
+       */
+      struct Entry {
+        Address         address; ///< Address of parameter
+        Data            data;    ///< current Data
+        std :: uint32_t version; ///< version of last change
+      };
+
+      /**
+       * @brief order of entries by Address
+       */
+      struct Less {
+        bool operator() ( const Entry& lhs, const Address& rhs ) const { return lhs.address < rhs; }
+      };
+
+      std :: vector< Entry >         _entries; ///< parameters sorted by Address
+      std :: uint32_t                _version; ///< version of last change, 0 for empty store
+      mutable std :: vector< Data >  _run;     ///< Data of consecutive Addresses in diff(), kept to reuse its capacity
+
+    public:
+
+      /**
+       * @brief default constructor, empty store of version 0
+       */
+      ParameterStore( void ) : _entries(), _version( 0 ), _run() {}
+
+
+      std :: uint32_t version( void ) const { return _version; }         ///< version of last change
+      size_type       size   ( void ) const { return _entries.size(); }  ///< number of parameters
+
+
+      /**
+       * @brief set Data of a parameter
+       *
+       * @param[in] address   Address of parameter
+       * @param[in] data      new Data
+       * @return              version of the parameter, not changed if data is same as current one
+       */
+      std :: uint32_t set( const Address& address, const Data& data ){
+
+        std :: vector< Entry > :: iterator entry = std :: lower_bound( _entries.begin(), _entries.end(), address, Less() );
+
+        if( entry == _entries.end() || entry -> address != address ){
+          _entries.insert( entry, Entry{ address, data, ++ _version } );
+          return _version;
+        }
+
+        if( std :: memcmp( &entry -> data, &data, sizeof( Data ) ) == 0 )
+          return entry -> version;
+
+        entry -> data    = data;
+        entry -> version = ++ _version;
+        return _version;
+      }
+
+      /**
+       * @brief get Data of a parameter
+       *
+       * @param[in]   address   Address of parameter
+       * @param[out]  data      current Data, written only when this function returns true
+       * @return              false if parameter is not set
+       */
+      bool get( const Address& address, Data& data ) const {
+
+        std :: vector< Entry > :: const_iterator entry = std :: lower_bound( _entries.begin(), _entries.end(), address, Less() );
+
+        if( entry == _entries.end() || entry -> address != address )
+          return false;
+
+        data = entry -> data;
+        return true;
+      }
+
+
+      /**
+       * @brief encode all parameters
+       *
+       * @param[out] output   encoded octets are appended
+       * @return              version of the snapshot
+       */
+      std :: uint32_t snapshot( std :: vector< value_type >& output ) const { return diff( 0, output ); }
+
+      /**
+       * @brief encode parameters changed after a version
+       *
+       * @param[in]   since     version receiver already has
+       * @param[out]  output    encoded octets are appended
+       * @return                version of the diff, receiver has this version after applying it
+       */
+      std :: uint32_t diff( const std :: uint32_t since, std :: vector< value_type >& output ) const {
+
+        std :: vector< Data >& run = _run;
+        run.clear();
+
+        Address first = 0;
+
+        for( const Entry& entry : _entries ){
+
+          if( entry.version <= since )
+            continue;
+
+          if( ! run.empty() && (entry.address != first + run.size() || run.size() == Serialized_Bulk :: MAX_COUNT) ){
+            append( first, run, output );
+            run.clear();
+          }
+
+          if( run.empty() )
+            first = entry.address;
+          run.push_back( entry.data );
+        }
+
+        if( ! run.empty() )
+          append( first, run, output );
+
+        Serialized marker;
+        marker.encode( static_cast< Address >( _version ), Serialized :: KIND_SYNC );
+        output.insert( output.end(), &marker[ 0 ], &marker[ 0 ] + Serialized :: SIZE );
+
+        return _version;
+      }
+
+
+    private:
+
+      /**
+       * @brief encode Data of consecutive Addresses
+       *
+       * @param[in]   first     Address of first Data
+       * @param[in]   run       Data of consecutive Addresses
+       * @param[out]  output    encoded octets are appended
+       */
+      static void append( const Address first, const std :: vector< Data >& run, std :: vector< value_type >& output ){
+
+        const size_type offset = output.size();
+
+        if( run.size() == 1 ){
+          Serialized frame;
+          output.resize( offset + Serialized :: SIZE * 2 );
+          frame.encode( first );
+          std :: copy( &frame[ 0 ], &frame[ 0 ] + Serialized :: SIZE, output.begin() + offset );
+          frame.encode( run[ 0 ] );
+          std :: copy( &frame[ 0 ], &frame[ 0 ] + Serialized :: SIZE, output.begin() + offset + Serialized :: SIZE );
+          return;
+        }
+
+        output.resize( offset + Serialized_Bulk :: size( run.size() ) );
+        Serialized_Bulk :: encode( first, run.data(), run.size(), output.data() + offset );
+      }
+
+  };
+
+
+
+  /**
+   * @brief this class provides receiver side of snapshot and diff
+   *
+   * @note this class is not thread safe
+   */
+  class Serialized_StateReceiver {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      /**
+       * @brief handler called with a batch of decoded parameters
+       */
+      using Handler = std :: function< void( const Message* messages, size_type count ) >;
+
+      constexpr static size_type BATCH = 256; ///< messages per handler call
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+
+      Handler                    _handler; ///< handler of decoded parameters
+      std :: vector< value_type > _buffer;  ///< octets of incomplete frame
+      std :: vector< Data >       _data;    ///< decoded Data of a bulk frame
+      std :: vector< Message >    _batch;   ///< decoded parameters not passed to handler yet
+      std :: uint32_t             _version; ///< version of last marker
+      bool                        _synced;  ///< true if a marker was received
+      size_type                   _invalid; ///< number of discarded frames
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] handler   called with batches of decoded parameters
+       */
+      explicit Serialized_StateReceiver( Handler handler ) :
+          _handler( std :: move( handler ) )
+        , _buffer()
+        , _data( Serialized_Bulk :: MAX_COUNT )
+        , _batch()
+        , _version( 0 )
+        , _synced( false )
+        , _invalid( 0 )
+      {
+        _batch.reserve( BATCH );
+      }
+
+
+      std :: uint32_t version( void ) const { return _version; } ///< version of last applied snapshot or diff
+      bool            synced ( void ) const { return _synced;  } ///< true if a snapshot or diff was applied completely
+      size_type       invalid( void ) const { return _invalid; } ///< number of discarded frames
+
+
+      /**
+       * @brief forget version and incomplete frame, ex. at reconnection to other sender
+       */
+      void reset( void ){
+        _buffer.clear();
+        _batch.clear();
+        _version = 0;
+        _synced  = false;
+      }
+
+
+      /**
+       * @brief decode octets of snapshot or diff, and call handler
+       *
+       * input can be split at any position, incomplete frame is kept until next call.
+       *
+       * @param[in] input   start of received octets
+       * @param[in] length  number of received octets
+       * @return            number of decoded parameters
+       */
+      size_type apply( const value_type* input, const size_type length ){
+
+        size_type count = 0;
+
+        if( _buffer.empty() ){
+          const size_type used = consume( input, length, count );
+          _buffer.assign( input + used, input + length );
+        }
+        else {
+          _buffer.insert( _buffer.end(), input, input + length );
+          const size_type used = consume( _buffer.data(), _buffer.size(), count );
+          _buffer.erase( _buffer.begin(), _buffer.begin() + used );
+        }
+
+        flush();
+        return count;
+      }
+
+
+    private:
+
+      /**
+       * @brief decode complete frames
+       *
+       * @param[in]   input     start of octets
+       * @param[in]   length    number of octets
+       * @param[out]  count     number of decoded parameters is added
+       * @return                number of used octets, the rest is an incomplete frame
+       */
+      size_type consume( const value_type* input, const size_type length, size_type& count ){
+
+        constexpr size_type SIZE = Serialized :: SIZE;
+
+        size_type i = 0;
+
+        while( i < length ){
+
+          if( (input[ i ] & header_bit) == 0 ){
+            ++ i;
+            if( i == length || (input[ i ] & header_bit) != 0 )
+              ++ _invalid;
+            continue;
+          }
+
+          if( length - i < SIZE )
+            return i;
+
+          Serialized frame( input[ i ], input[ i + 1 ], input[ i + 2 ], input[ i + 3 ], input[ i + 4 ] );
+
+          if( ! frame.is_address( frame.kind() ) ){
+            ++ i;
+            ++ _invalid;
+            continue;
+          }
+
+          const value_type kind = frame.kind();
+
+          if( kind == Serialized :: KIND_ADDRESS ){
+
+            if( length - i < SIZE * 2 )
+              return i;
+
+            Serialized data( input[ i + 5 ], input[ i + 6 ], input[ i + 7 ], input[ i + 8 ], input[ i + 9 ] );
+            if( ! data.is_data() ){
+              i += SIZE;
+              ++ _invalid;
+              continue;
+            }
+
+            Message message;
+            frame.decode( message.address );
+            data .decode( message.data );
+            emit( message );
+            ++ count;
+            i += SIZE * 2;
+          }
+          else if( kind == Serialized :: KIND_BULK ){
+
+            if( length - i < Serialized_Bulk :: HEADER_SIZE + Serialized_Bulk :: LENGTH_SIZE )
+              return i;
+
+            if( ! Serialized_Bulk :: is_bulk( input + i, length - i ) ){
+              i += SIZE;
+              ++ _invalid;
+              continue;
+            }
+
+            const size_type n = Serialized_Bulk :: count( input + i );
+            if( length - i < Serialized_Bulk :: size( n ) )
+              return i;
+
+            Address first;
+            if( Serialized_Bulk :: decode( input + i, length - i, first, _data.data(), _data.size() ) == 0 ){
+              i += SIZE;
+              ++ _invalid;
+              continue;
+            }
+
+            for( size_type k = 0 ; k < n ; ++ k )
+              emit( Message{ static_cast< Address >( first + k ), _data[ k ] } );
+            count += n;
+            i     += Serialized_Bulk :: size( n );
+          }
+          else if( kind == Serialized :: KIND_SYNC ){
+            Address version;
+            frame.decode( version );
+            flush();
+            _version = static_cast< std :: uint32_t >( version );
+            _synced  = true;
+            i += SIZE;
+          }
+          else
+            i += SIZE;
+        }
+
+        return i;
+      }
+
+      /**
+       * @brief add a parameter to batch
+       */
+      void emit( const Message& message ){
+        _batch.push_back( message );
+        if( _batch.size() == BATCH )
+          flush();
+      }
+
+      /**
+       * @brief pass batch to handler
+       */
+      void flush( void ){
+        if( _batch.empty() )
+          return;
+        _handler( _batch.data(), _batch.size() );
+        _batch.clear();
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_StateSync_h */
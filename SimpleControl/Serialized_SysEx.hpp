@@ -0,0 +1,206 @@
+/**
+ *  @file           Serialized_SysEx.hpp
+ *  @brief          This class provides parser of frames packed in MIDI System Exclusive messages.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * A SysEx message carries many frames, `F0 <manufacturer id> <packed frames> F7`.
+ *
+ * Octets of Address class frames have header bit, which is not allowed in SysEx data,
+ * so frames are packed by groups of 7 octets. Each group starts with a flag octet,
+ * bit k of flag octet is header bit of octet k of the group, and the other octets have lower 7 bits.
+ *
+ * | part             | octets                           |
+ * | ---------------- | -------------------------------- |
+ * | start            | `F0`                             |
+ * | manufacturer id  | 1 octet, or 3 octets from `00`    |
+ * | packed frames    | ( flag + up to 7 octets ) repeated |
+ * | end              | `F7`                             |
+ *
+ * Sender puts only whole frames into a SysEx message, see Serialized_SysExSender.
+ * Parser unpacks and decodes frames in one pass, keeping frame state between SysEx messages like Serialized_Parser.
+ * Real-time MIDI messages ( `F8` - `FF` ) inside SysEx are ignored, other status octets abort the SysEx.
+ */
+
+#ifndef SimpleControlSerialized_SysEx_h
+#define SimpleControlSerialized_SysEx_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Parser.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides constants of SysEx packing
+   */
+  class Serialized_SysEx {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      constexpr static value_type START          = 0xF0; ///< start of SysEx
+      constexpr static value_type END            = 0xF7; ///< end of SysEx
+      constexpr static value_type NON_COMMERCIAL = 0x7D; ///< manufacturer id for non commercial use, default id
+      constexpr static size_type  GROUP          = 7;    ///< octets per flag octet
+  };
+
+
+
+  /**
+   * @brief this class provides one pass parser of frames in SysEx messages
+   */
+  class Serialized_SysExParser {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+    private:
+      constexpr static value_type header_bit = 0b10000000;
+      constexpr static value_type realtime   = 0xF8;
+
+      /**
+       * @brief state of SysEx
+       */
+      enum State : unsigned char {
+          IDLE    ///< outside of SysEx
+        , HEADER  ///< reading manufacturer id
+        , PAYLOAD ///< reading packed frames
+        , SKIP    ///< SysEx of other manufacturer id
+      };
+
+      Serialized_Parser _parser;   ///< parser of unpacked octets
+      value_type        _id[ 3 ];  ///< manufacturer id
+      size_type         _id_size;  ///< octets of manufacturer id
+      State             _state;    ///< state of SysEx
+      size_type         _position; ///< octets of id read in HEADER, octet in group in PAYLOAD, 0 is flag octet
+      value_type        _flags;    ///< flag octet of current group
+
+      uint32_t _received; ///< number of finished SysEx messages of manufacturer id
+      uint32_t _aborted;  ///< number of SysEx messages aborted by status octet
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] id    manufacturer id, 0 for 3 octets id `00 id2 id3`
+       * @param[in] id2   2nd octet of 3 octets id
+       * @param[in] id3   3rd octet of 3 octets id
+       */
+      explicit Serialized_SysExParser( const value_type id = Serialized_SysEx :: NON_COMMERCIAL, const value_type id2 = 0, const value_type id3 = 0 ) :
+          _parser()
+        , _id{ id, id2, id3 }
+        , _id_size( id == 0 ? 3 : 1 )
+        , _state( IDLE )
+        , _position( 0 )
+        , _flags( 0 )
+        , _received( 0 )
+        , _aborted( 0 )
+      {}
+
+
+      uint32_t  received( void ) const { return _received; }           ///< number of finished SysEx messages of manufacturer id
+      uint32_t  aborted ( void ) const { return _aborted;  }           ///< number of SysEx messages aborted by status octet
+      size_type invalid ( void ) const { return _parser.invalid(); }   ///< number of discarded frames, see Serialized_Parser
+
+
+      /**
+       * @brief discard current SysEx and frame state
+       */
+      void reset( void ){
+        _parser.reset();
+        _state    = IDLE;
+        _position = 0;
+      }
+
+
+      /**
+       * @brief parse a MIDI octet
+       *
+       * @param[in]   octet     received MIDI octet
+       * @param[out]  message   decoded message, written only when this function returns true
+       * @return                true if a message is decoded
+       */
+      bool parse( const value_type octet, Message& message ){
+
+        if( (octet & header_bit) != 0 ){
+
+          if( octet >= realtime )
+            return false;
+
+          if( _state == PAYLOAD && octet != Serialized_SysEx :: END ){
+            ++ _aborted;
+            _parser.reset();
+          }
+          else if( _state == PAYLOAD )
+            ++ _received;
+
+          _state    = octet == Serialized_SysEx :: START ? HEADER : IDLE;
+          _position = 0;
+          return false;
+        }
+
+        switch( _state ){
+
+          case HEADER :
+            if( octet != _id[ _position ] )
+              _state = SKIP;
+            else if( ++ _position == _id_size ){
+              _state    = PAYLOAD;
+              _position = 0;
+            }
+            return false;
+
+          case PAYLOAD :
+            if( _position == 0 ){
+              _flags    = octet;
+              _position = 1;
+              return false;
+            }
+            {
+              const value_type unpacked = static_cast< value_type >( octet | ((_flags >> (_position - 1)) & 1) << 7 );
+              _position = _position == Serialized_SysEx :: GROUP ? 0 : _position + 1;
+              return _parser.parse( unpacked, message );
+            }
+
+          default :
+            return false;
+        }
+      }
+
+
+      /**
+       * @brief parse MIDI octets
+       *
+       * parsing stops when output is full or input is finished.
+       *
+       * @param[in]   input     start of received MIDI octets
+       * @param[in]   length    number of received octets
+       * @param[out]  output    start of message array
+       * @param[in]   capacity  number of messages output can store
+       * @param[out]  count     number of decoded messages
+       * @return                number of parsed octets
+       */
+      size_type parse( const value_type* input, const size_type length, Message* output, const size_type capacity, size_type& count ){
+
+        count = 0;
+
+        size_type i = 0;
+        while( i < length && count < capacity )
+          if( parse( input[ i ++ ], output[ count ] ) )
+            ++ count;
+
+        return i;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_SysEx_h */
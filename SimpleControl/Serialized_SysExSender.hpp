@@ -0,0 +1,240 @@
+/**
+ *  @file           Serialized_SysExSender.hpp
+ *  @brief          This class provides sender packing many frames into MIDI System Exclusive messages, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Messages are packed into the current SysEx message, see Serialized_SysEx for the packing.
+ * The current SysEx message is finished when
+ *
+ * * next message doesn't fit in `max_size` octets, including `F0` and `F7`
+ * * its first message waited for `latency`, checked by poll()
+ * * flush() is called
+ *
+ * Finished SysEx messages are pulled as whole messages, ex. written to a rawmidi device or a pipe.
+ * Each message costs 10 octets of frames + about 1.4 octets of flags, instead of a SysEx message per frame.
+ */
+
+#ifndef SimpleControlSerialized_SysExSender_h
+#define SimpleControlSerialized_SysExSender_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_SysEx.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides SysEx packing sender with size and latency bounds
+   *
+   * @note this class is not thread safe
+   */
+  class Serialized_SysExSender {
+
+    public:
+      using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+      using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+      using clock      = std :: chrono :: steady_clock; ///< clock of latency
+      using time_point = clock :: time_point;           ///< time type
+      using duration   = clock :: duration;             ///< latency type
+
+    private:
+      constexpr static size_type GROUP = Serialized_SysEx :: GROUP;
+
+      value_type _id[ 3 ];  ///< manufacturer id
+      size_type  _id_size;  ///< octets of manufacturer id
+      size_type  _max_size; ///< maximum octets of a SysEx message
+      duration   _latency;  ///< maximum wait of first message in a SysEx message
+
+      std :: vector< value_type > _current; ///< current SysEx message without `F7`
+      time_point                  _first;   ///< time of first message in _current
+      size_type                   _flag;    ///< position of flag octet of current group
+      size_type                   _filled;  ///< octets in current group, GROUP if next octet needs new group
+
+      std :: vector< value_type > _ready;   ///< finished SysEx messages
+      std :: deque< size_type >   _sizes;   ///< octets of each finished SysEx message
+      size_type                   _head;    ///< first octet of _ready not pulled yet
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] max_size    maximum octets of a SysEx message including `F0` and `F7`, ex. limit of MIDI driver
+       * @param[in] latency     maximum wait of a message before its SysEx message is finished by poll()
+       * @param[in] id          manufacturer id, 0 for 3 octets id `00 id2 id3`
+       * @param[in] id2         2nd octet of 3 octets id
+       * @param[in] id3         3rd octet of 3 octets id
+       */
+      explicit Serialized_SysExSender(
+            const size_type  max_size = 256
+          , const duration   latency  = std :: chrono :: milliseconds( 1 )
+          , const value_type id       = Serialized_SysEx :: NON_COMMERCIAL
+          , const value_type id2      = 0
+          , const value_type id3      = 0 ) :
+          _id{ id, id2, id3 }
+        , _id_size( id == 0 ? 3 : 1 )
+        , _max_size( max_size )
+        , _latency( latency )
+        , _current()
+        , _first()
+        , _flag( 0 )
+        , _filled( GROUP )
+        , _ready()
+        , _sizes()
+        , _head( 0 )
+      {
+        _current.reserve( max_size );
+      }
+
+
+      size_type pending( void ) const { return _current.size(); }         ///< octets of current SysEx message, 0 if none
+      size_type ready  ( void ) const { return _ready.size() - _head; }   ///< octets of finished SysEx messages
+      size_type count  ( void ) const { return _sizes.size(); }           ///< number of finished SysEx messages
+
+
+      /**
+       * @brief pack a message as Address and Data frames
+       *
+       * @param[in] message   message to send
+       * @param[in] now       current time
+       * @return              false if max_size is too small for a message
+       */
+      bool push( const Message& message, const time_point now = clock :: now() ){
+
+        const Serialized address( message.address );
+        const Serialized data   ( message.data    );
+
+        value_type frames[ Serialized :: SIZE * 2 ];
+        for( size_type i = 0 ; i < Serialized :: SIZE ; ++ i ){
+          frames[ i ]                      = address[ i ];
+          frames[ Serialized :: SIZE + i ] = data[ i ];
+        }
+
+        return push( frames, sizeof( frames ), now );
+      }
+
+      /**
+       * @brief pack encoded frames, they are kept in one SysEx message
+       *
+       * @param[in] frames    whole encoded frames, ex. bulk array or integrity frame
+       * @param[in] length    octets of frames
+       * @param[in] now       current time
+       * @return              false if frames don't fit in max_size
+       */
+      bool push( const value_type* frames, const size_type length, const time_point now = clock :: now() ){
+
+        if( ! _current.empty() && _current.size() + packed( length, _filled ) + 1 > _max_size )
+          flush();
+
+        if( _current.empty() ){
+          if( 1 + _id_size + packed( length, GROUP ) + 1 > _max_size )
+            return false;
+          _current.push_back( static_cast< value_type >( Serialized_SysEx :: START ) );
+          _current.insert( _current.end(), _id, _id + _id_size );
+          _first  = now;
+          _filled = GROUP;
+        }
+
+        for( size_type i = 0 ; i < length ; ++ i ){
+          if( _filled == GROUP ){
+            _flag   = _current.size();
+            _filled = 0;
+            _current.push_back( 0 );
+          }
+          _current[ _flag ] |= static_cast< value_type >( (frames[ i ] >> 7) << _filled );
+          _current.push_back( static_cast< value_type >( frames[ i ] & 0x7F ) );
+          ++ _filled;
+        }
+
+        return true;
+      }
+
+
+      /**
+       * @brief finish current SysEx message if its first message waited for latency
+       *
+       * @param[in] now   current time
+       * @return          true if a SysEx message is finished
+       */
+      bool poll( const time_point now = clock :: now() ){
+        if( _current.empty() || now - _first < _latency )
+          return false;
+        flush();
+        return true;
+      }
+
+      /**
+       * @brief finish current SysEx message
+       */
+      void flush( void ){
+
+        if( _current.empty() )
+          return;
+
+        _current.push_back( static_cast< value_type >( Serialized_SysEx :: END ) );
+        _ready.insert( _ready.end(), _current.begin(), _current.end() );
+        _sizes.push_back( _current.size() );
+        _current.clear();
+        _filled = GROUP;
+      }
+
+
+      /**
+       * @brief take finished SysEx messages
+       *
+       * @param[out]  output    start of MIDI octets
+       * @param[in]   capacity  octets output can store
+       * @return                octets written to output, whole SysEx messages only
+       */
+      size_type pull( value_type* output, const size_type capacity ){
+
+        size_type length = 0;
+
+        while( ! _sizes.empty() && length + _sizes.front() <= capacity ){
+          std :: memcpy( output + length, _ready.data() + _head, _sizes.front() );
+          length += _sizes.front();
+          _head  += _sizes.front();
+          _sizes.pop_front();
+        }
+
+        // drop pulled octets once they are half of _ready, so _ready is bounded by twice the unpulled octets
+        if( _sizes.empty() ){
+          _ready.clear();
+          _head = 0;
+        }
+        else if( _head * 2 >= _ready.size() ){
+          _ready.erase( _ready.begin(), _ready.begin() + _head );
+          _head = 0;
+        }
+        return length;
+      }
+
+
+    private:
+
+      /**
+       * @brief octets of packed frames including new flag octets
+       *
+       * @param[in] length  octets of frames
+       * @param[in] filled  octets in current group
+       */
+      static size_type packed( const size_type length, const size_type filled ){
+        const size_type room = GROUP - filled;
+        return length + (length > room ? (length - room + GROUP - 1) / GROUP : 0);
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSerialized_SysExSender_h */
@@ -8,6 +8,16 @@
 
 #include "SimpleControl_Types.hpp"
 #include "Serialized.hpp"
+#include "Serialized_16.hpp"
+#include "Serialized_Bulk.hpp"
+#include "Serialized_Quantized.hpp"
+#include "Serialized_Short.hpp"
+#include "Serialized_Parser.hpp"
+#include "Serialized_RunningStatus.hpp"
+#include "Serialized_Integrity.hpp"
+#include "Serialized_Credit.hpp"
+#include "Serialized_SysEx.hpp"
+#include "SimpleControl_RateLimiter.hpp"
 
 
 
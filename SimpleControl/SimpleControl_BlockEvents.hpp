@@ -0,0 +1,242 @@
+/**
+ *  @file           SimpleControl_BlockEvents.hpp
+ *  @brief          This class provides wait free handoff of timestamped messages to audio thread, per block event lists, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * 3 event lists are allocated at construction, and each list is owned by one of
+ *
+ * | owner    | list   | operation                                                            |
+ * | -------- | ------ | -------------------------------------------------------------------- |
+ * | writer   | back   | push() inserts events in order of time, publish() exchanges back with middle |
+ * | exchange | middle | an atomic index with `FRESH` flag, set by writer and cleared by reader |
+ * | reader   | front  | acquire() merges events left in front into middle and exchanges them when middle is fresh |
+ *
+ * Writer publishes only when reader has taken the previous list, otherwise events stay in back list
+ * and are published later, so no event is dropped and no list is shared by both threads.
+ * Writer doesn't touch middle while it is fresh, so reader merges into it before the exchange,
+ * and events left in front for later blocks never hold back newer lists. Merged events over capacity are dropped, latest first.
+ * Each side is one atomic load and at most one atomic exchange, without allocation, locks or system calls.
+ *
+ * Time of events is sample time ( ex. sample count since start of stream ), acquire() returns events of a block
+ * with their sample offsets in the block.
+ */
+
+#ifndef SimpleControlSimpleControl_BlockEvents_h
+#define SimpleControlSimpleControl_BlockEvents_h
+
+#include "SimpleControl_Types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides wait free triple buffered event lists
+   *
+   * @note push() / publish() are called from one writer thread, acquire() is called from one reader thread
+   */
+  class BlockEvents {
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+      /**
+       * @brief a timestamped message
+       */
+      struct Event {
+        std :: uint64_t time;    ///< sample time of message
+        std :: uint32_t offset;  ///< sample offset in the block, written by acquire()
+        Address         address; ///< Address of message
+        Data            data;    ///< Data of message
+      };
+
+      /**
+       * @brief view of events of a block, sorted by time, valid until next acquire()
+       */
+      struct Span {
+        const Event* data; ///< first event
+        size_type    size; ///< number of events
+
+        const Event* begin( void ) const { return data; }        ///< first event
+        const Event* end  ( void ) const { return data + size; } ///< end of events
+        bool         empty( void ) const { return size == 0; }   ///< true if no event
+      };
+
+    private:
+      constexpr static size_type       CACHE_LINE = 64;
+      constexpr static std :: uint32_t FRESH      = 0b100; ///< flag of middle index, set while reader has not taken it
+      constexpr static std :: uint32_t INDEX      = 0b011; ///< index bits of middle
+
+      std :: vector< Event > _lists[ 3 ]; ///< event lists
+      size_type              _capacity;  ///< events per list
+
+      alignas( CACHE_LINE ) std :: atomic< std :: uint32_t > _middle; ///< index of middle list and FRESH flag
+
+      alignas( CACHE_LINE ) std :: uint32_t _back;    ///< index of writer list
+      std :: uint64_t                       _dropped; ///< number of events dropped by full list
+
+      alignas( CACHE_LINE ) std :: uint32_t _front;    ///< index of reader list
+      size_type                             _position; ///< first event of front list not acquired yet
+      std :: uint64_t                       _overflow; ///< number of events dropped by merge over capacity
+
+    public:
+
+      /**
+       * @brief constructor, allocates all lists
+       *
+       * @param[in] capacity  events per list, events over capacity before publish() are dropped
+       */
+      explicit BlockEvents( const size_type capacity ) :
+          _lists()
+        , _capacity( capacity )
+        , _middle( 1 )
+        , _back( 0 )
+        , _dropped( 0 )
+        , _front( 2 )
+        , _position( 0 )
+        , _overflow( 0 )
+      {
+        for( std :: vector< Event >& list : _lists )
+          list.reserve( capacity );
+      }
+
+      BlockEvents( const BlockEvents& ) = delete;
+      BlockEvents& operator= ( const BlockEvents& ) = delete;
+
+
+      size_type       capacity( void ) const { return _capacity; } ///< events per list
+      std :: uint64_t dropped ( void ) const { return _dropped; }  ///< number of dropped events, read from writer thread
+      std :: uint64_t overflow( void ) const { return _overflow; } ///< number of events dropped by merge, read from reader thread
+
+
+      /**
+       * @brief append an event to back list, called from writer thread
+       *
+       * @param[in] message   decoded message
+       * @param[in] time      sample time of message
+       * @return              false if back list is full, the event is dropped
+       */
+      bool push( const Message& message, const std :: uint64_t time ){
+
+        std :: vector< Event >& list = _lists[ _back ];
+
+        if( list.size() == _capacity ){
+          ++ _dropped;
+          return false;
+        }
+
+        // events are mostly in order, so insertion from the end is short. insert doesn't allocate under capacity
+        std :: vector< Event > :: iterator position = list.end();
+        while( position != list.begin() && time < (position - 1) -> time )
+          -- position;
+
+        list.insert( position, Event{ time, 0, message.address, message.data } );
+        return true;
+      }
+
+      /**
+       * @brief pass back list to reader, called from writer thread
+       *
+       * @return  false if reader has not taken the previous list yet, events are kept and published by next call
+       */
+      bool publish( void ){
+
+        std :: vector< Event >& list = _lists[ _back ];
+
+        if( list.empty() || (_middle.load( std :: memory_order_acquire ) & FRESH) != 0 )
+          return false;
+
+        // reader doesn't exchange middle while it is not fresh, so middle is the list reader released
+        _back = _middle.exchange( _back | FRESH, std :: memory_order_acq_rel ) & INDEX;
+        _lists[ _back ].clear();
+        return true;
+      }
+
+
+      /**
+       * @brief events of a block, called from reader thread once per block
+       *
+       * events earlier than the block have offset 0, events later than the block are kept for next blocks.
+       * new list is taken as soon as it is published, events left in front list are merged into it.
+       *
+       * @param[in] start     sample time of first sample of the block
+       * @param[in] frames    samples of the block
+       * @return              events in the block, sorted by time
+       */
+      Span acquire( const std :: uint64_t start, const size_type frames ){
+
+        const std :: uint32_t middle = _middle.load( std :: memory_order_acquire );
+        if( (middle & FRESH) != 0 ){
+          merge( _lists[ _front ], _lists[ middle & INDEX ] );
+          _front    = _middle.exchange( _front, std :: memory_order_acq_rel ) & INDEX;
+          _position = 0;
+        }
+
+        std :: vector< Event >& list  = _lists[ _front ];
+        const std :: uint64_t   end   = start + frames;
+        const size_type         first = _position;
+
+        for( ; _position < list.size() && list[ _position ].time < end ; ++ _position ){
+          Event& event = list[ _position ];
+          event.offset = event.time < start ? 0 : static_cast< std :: uint32_t >( event.time - start );
+        }
+
+        return Span{ list.data() + first, _position - first };
+      }
+
+
+    private:
+
+      /**
+       * @brief merge events left in front list into fresh middle list, called from reader thread
+       *
+       * lists are merged from the end, so no temporary list is required, and events over capacity are latest ones.
+       * events of front come first at same time, they are published earlier.
+       * latest events are dropped before any event is moved, so events left in fresh at the end are already in place.
+       *
+       * @param[in]     front   front list, events from _position are merged
+       * @param[in,out] fresh   middle list, not touched by writer while it is fresh
+       */
+      void merge( const std :: vector< Event >& front, std :: vector< Event >& fresh ){
+
+        const size_type rest  = front.size() - _position;
+        if( rest == 0 )
+          return;
+
+        const size_type total = fresh.size() + rest;
+        const size_type keep  = total < _capacity ? total : _capacity;
+        size_type       skip  = total - keep;
+        size_type       i     = fresh.size();
+        size_type       j     = front.size();
+        size_type       k     = keep;
+
+        // resize doesn't allocate under capacity
+        fresh.resize( keep );
+
+        while( j > _position ){
+
+          // later event goes to the end, fresh one at same time
+          const bool   later = i == 0 || fresh[ i - 1 ].time < front[ j - 1 ].time;
+          const Event& event = later ? front[ -- j ] : fresh[ -- i ];
+
+          if( skip != 0 ){
+            -- skip;
+            ++ _overflow;
+            continue;
+          }
+          fresh[ -- k ] = event;
+        }
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_BlockEvents_h */
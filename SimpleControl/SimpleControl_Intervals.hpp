@@ -0,0 +1,154 @@
+/**
+ *  @file           SimpleControl_Intervals.hpp
+ *  @brief          This class provides sorted elementary intervals of Address ranges with branchless search, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Ranges `[ low, high ]` split all Addresses into elementary intervals, all Addresses in an interval are in the same ranges.
+ * Each interval is kept as its first Address, the first interval starts at 0.
+ * Users keep a value of each interval, ex. output mask of Serialized_Router or subscriber set of SubscriptionIndex,
+ * and fill values of a range by `first( low )` to `end( high )`.
+ *
+ * find() is a branchless binary search, batch find() runs `LANES` searches at once to hide memory latency of the table.
+ */
+
+#ifndef SimpleControlSimpleControl_Intervals_h
+#define SimpleControlSimpleControl_Intervals_h
+
+#include "SimpleControl_Types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides elementary intervals of Address ranges
+   */
+  class Intervals {
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+    private:
+      constexpr static Address last_address = static_cast< Address >( ~static_cast< Address >( 0 ) );
+
+      std :: vector< Address > _bounds; ///< start of elementary intervals, first is 0
+
+    public:
+
+      /**
+       * @brief default constructor, one interval of all Addresses
+       */
+      Intervals( void ) : _bounds( 1, 0 ) {}
+
+
+      size_type      size( void ) const { return _bounds.size(); } ///< number of intervals
+      const Address* data( void ) const { return _bounds.data(); } ///< start of each interval
+
+
+      /**
+       * @brief remove all ranges
+       */
+      void clear( void ){
+        _bounds.assign( 1, 0 );
+      }
+
+      /**
+       * @brief add bounds of a range, call sort() after all ranges are added
+       *
+       * @param[in] low     first Address
+       * @param[in] high    last Address
+       */
+      void add( const Address& low, const Address& high ){
+        _bounds.push_back( low );
+        if( high != last_address )
+          _bounds.push_back( high + 1 );
+      }
+
+      /**
+       * @brief sort bounds and remove duplicates
+       */
+      void sort( void ){
+        std :: sort( _bounds.begin(), _bounds.end() );
+        _bounds.erase( std :: unique( _bounds.begin(), _bounds.end() ), _bounds.end() );
+      }
+
+
+      /**
+       * @brief index of first interval of a range
+       *
+       * @param[in] low   first Address of an added range
+       */
+      size_type first( const Address& low ) const {
+        return static_cast< size_type >( std :: lower_bound( _bounds.begin(), _bounds.end(), low ) - _bounds.begin() );
+      }
+
+      /**
+       * @brief index next to last interval of a range
+       *
+       * @param[in] high  last Address of an added range
+       */
+      size_type end( const Address& high ) const {
+        return high == last_address ? _bounds.size() : first( high + 1 );
+      }
+
+
+      /**
+       * @brief index of interval of an Address
+       *
+       * @param[in] address   Address to search
+       */
+      size_type find( const Address& address ) const {
+
+        const Address* base = _bounds.data();
+        size_type      n    = _bounds.size();
+
+        while( n > 1 ){
+          const size_type half = n / 2;
+          base  = base[ half ] <= address ? base + half : base;
+          n    -= half;
+        }
+
+        return static_cast< size_type >( base - _bounds.data() );
+      }
+
+      /**
+       * @brief index of interval of `LANES` Addresses, searched at once
+       *
+       * @param[in]   addresses   `LANES` Addresses to search
+       * @param[out]  output      index of interval of each Address, requires `LANES` indices
+       */
+      template < size_type LANES >
+      void find( const Address* addresses, size_type* output ) const {
+
+        const Address* const bounds = _bounds.data();
+
+        const Address* base[ LANES ];
+        for( size_type k = 0 ; k < LANES ; ++ k )
+          base[ k ] = bounds;
+
+        for( size_type n = _bounds.size() ; n > 1 ; ){
+          const size_type half = n / 2;
+          for( size_type k = 0 ; k < LANES ; ++ k ){
+            __builtin_prefetch( base[ k ] + half / 2 );
+            __builtin_prefetch( base[ k ] + half + half / 2 );
+          }
+          for( size_type k = 0 ; k < LANES ; ++ k )
+            base[ k ] = base[ k ][ half ] <= addresses[ k ] ? base[ k ] + half : base[ k ];
+          n -= half;
+        }
+
+        for( size_type k = 0 ; k < LANES ; ++ k )
+          output[ k ] = static_cast< size_type >( base[ k ] - bounds );
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_Intervals_h */
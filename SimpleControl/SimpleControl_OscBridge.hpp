@@ -0,0 +1,519 @@
+/**
+ *  @file           SimpleControl_OscBridge.hpp
+ *  @brief          This class provides bridge between OSC packets and SimpleControl messages, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * OSC paths are registered with Address by add(), and interned into an open addressing hash table.
+ *
+ * | direction              | function   | work                                                                 |
+ * | ---------------------- | ---------- | -------------------------------------------------------------------- |
+ * | OSC -> SimpleControl   | decode()   | parses messages and nested bundles in place, paths are looked up without copies |
+ * | SimpleControl -> OSC   | encode()   | writes a bundle of `,f` messages from prebuilt path and type tag octets |
+ *
+ * Argument k of an OSC message is sent to `Address + k`. Numeric arguments ( `f`, `i`, `d`, `h`, `T`, `F` )
+ * are converted to Data, other arguments are skipped but still counted in k.
+ *
+ * OSC paths are padded to 4 octets by NUL, so they are hashed and compared by 4 octets words.
+ * A small cache keyed by pointer and length of the path is checked before hashing,
+ * it hits when a receive buffer is reused for packets of the same layout. Cached paths are still compared.
+ *
+ * This class doesn't own sockets, pass received datagrams to decode() and send octets of encode().
+ */
+
+#ifndef SimpleControlSimpleControl_OscBridge_h
+#define SimpleControlSimpleControl_OscBridge_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized_FrameBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides OSC <-> SimpleControl translation by interned paths
+   *
+   * @note decode() builds the table when paths are changed, don't call it from multiple threads at the same time
+   */
+  class OscBridge {
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+      constexpr static size_type MAX_DEPTH = 8; ///< maximum depth of nested bundles
+
+    private:
+      constexpr static size_type      CACHE = 64;         ///< entries of pointer cache
+      constexpr static std :: uint32_t EMPTY = 0xFFFFFFFF; ///< empty slot of tables
+
+      /**
+       * @brief a registered path
+       */
+      struct Entry {
+        std :: uint32_t offset;  ///< start of path in _strings
+        std :: uint32_t size;    ///< octets of padded path
+        std :: uint32_t hash;    ///< hash of padded path
+        Address         address; ///< Address of path
+      };
+
+      /**
+       * @brief cached lookup of a path pointer
+       */
+      struct Cached {
+        const char*     pointer; ///< path in a packet
+        std :: uint32_t size;    ///< octets of padded path
+        std :: uint32_t entry;   ///< index of Entry
+      };
+
+      std :: vector< Entry >           _entries;   ///< registered paths
+      std :: vector< char >            _strings;   ///< padded path followed by `,f` type tag of each entry
+      std :: vector< std :: uint32_t > _paths;     ///< hash table of entries by path
+      std :: vector< std :: uint32_t > _addresses; ///< hash table of entries by Address, first added path of each Address
+      Cached                           _cache[ CACHE ]; ///< pointer cache
+      bool                             _dirty;     ///< true if paths are changed after build
+
+      std :: vector< Message > _messages;  ///< decoded messages of FrameBuffer decode()
+      std :: uint64_t          _unknown;   ///< number of messages of unknown path or Address
+      std :: uint64_t          _malformed; ///< number of malformed packets
+
+    public:
+
+      /**
+       * @brief default constructor, no paths
+       */
+      OscBridge( void ) :
+          _entries()
+        , _strings()
+        , _paths()
+        , _addresses()
+        , _cache()
+        , _dirty( true )
+        , _messages()
+        , _unknown( 0 )
+        , _malformed( 0 )
+      {}
+
+
+      size_type       size     ( void ) const { return _entries.size(); } ///< number of add() calls
+      std :: uint64_t unknown  ( void ) const { return _unknown;   }      ///< number of messages of unknown path or Address
+      std :: uint64_t malformed( void ) const { return _malformed; }      ///< number of malformed packets
+
+
+      /**
+       * @brief register a path, a registered path is moved to new Address
+       *
+       * @param[in] path      OSC path, starts with `/`
+       * @param[in] address   Address of the path
+       * @return              false if path is invalid
+       */
+      bool add( const std :: string& path, const Address& address ){
+
+        if( path.empty() || path[ 0 ] != '/' || path.find( '\0' ) != std :: string :: npos )
+          return false;
+
+        const size_type padded = pad( path.size() + 1 );
+        const size_type offset = _strings.size();
+
+        _strings.resize( offset + padded + 4, '\0' );
+        std :: memcpy( _strings.data() + offset, path.data(), path.size() );
+        _strings[ offset + padded     ] = ',';
+        _strings[ offset + padded + 1 ] = 'f';
+
+        _entries.push_back( Entry{ static_cast< std :: uint32_t >( offset ), static_cast< std :: uint32_t >( padded )
+                                 , hash( _strings.data() + offset, padded ), address } );
+        _dirty = true;
+        return true;
+      }
+
+      /**
+       * @brief remove all paths
+       */
+      void clear( void ){
+        _entries.clear();
+        _strings.clear();
+        _dirty = true;
+      }
+
+
+      /**
+       * @brief Address of a path
+       *
+       * @param[in]   path      padded OSC path, NUL terminated and padded to 4 octets
+       * @param[in]   size      octets of padded path
+       * @param[out]  address   Address of the path, written only when this function returns true
+       * @return              false if path is not registered
+       */
+      bool find( const char* path, const size_type size, Address& address ){
+
+        if( _dirty )
+          build();
+
+        Cached& cached = _cache[ (reinterpret_cast< std :: uintptr_t >( path ) >> 2 ^ size) & (CACHE - 1) ];
+        if( cached.pointer == path && cached.size == size
+            && std :: memcmp( _strings.data() + _entries[ cached.entry ].offset, path, size ) == 0 ){
+          address = _entries[ cached.entry ].address;
+          return true;
+        }
+
+        const std :: uint32_t mask = static_cast< std :: uint32_t >( _paths.size() - 1 );
+        const std :: uint32_t code = hash( path, size );
+
+        for( std :: uint32_t slot = code & mask ; _paths[ slot ] != EMPTY ; slot = (slot + 1) & mask ){
+          const Entry& entry = _entries[ _paths[ slot ] ];
+          if( entry.hash == code && entry.size == size && std :: memcmp( _strings.data() + entry.offset, path, size ) == 0 ){
+            cached  = Cached{ path, static_cast< std :: uint32_t >( size ), _paths[ slot ] };
+            address = entry.address;
+            return true;
+          }
+        }
+        return false;
+      }
+
+
+      /**
+       * @brief decode an OSC packet ( message or bundle ) into messages
+       *
+       * messages before a malformed part of the packet are kept.
+       *
+       * @param[in]   packet    start of OSC packet, aligned or not
+       * @param[in]   length    octets of OSC packet
+       * @param[out]  output    decoded messages are appended
+       * @return                false if the packet is malformed
+       */
+      bool decode( const void* packet, const size_type length, std :: vector< Message >& output ){
+
+        if( _dirty )
+          build();
+
+        if( ! element( static_cast< const char* >( packet ), length, output, 0 ) ){
+          ++ _malformed;
+          return false;
+        }
+        return true;
+      }
+
+      /**
+       * @brief decode an OSC packet and append encoded messages to FrameBuffer
+       *
+       * @param[in]   packet    start of OSC packet
+       * @param[in]   length    octets of OSC packet
+       * @param[out]  output    decoded messages are appended and encoded in a batch
+       * @param[in]   timestamp time of messages
+       * @return                false if the packet is malformed
+       */
+      bool decode( const void* packet, const size_type length, FrameBuffer& output, const std :: uint64_t timestamp = 0 ){
+        _messages.clear();
+        const bool result = decode( packet, length, _messages );
+        output.append( _messages.data(), _messages.size(), timestamp );
+        return result;
+      }
+
+
+      /**
+       * @brief encode messages into an OSC packet
+       *
+       * a message is encoded as an OSC message, more messages as a bundle of immediate time tag.
+       * messages of unregistered Address are skipped.
+       *
+       * @param[in]   messages  messages to encode
+       * @param[in]   count     number of messages
+       * @param[out]  output    OSC packet, replaced
+       * @return                number of encoded messages
+       */
+      size_type encode( const Message* messages, const size_type count, std :: vector< char >& output ){
+
+        if( _dirty )
+          build();
+
+        output.clear();
+
+        const bool bundle = count > 1;
+        if( bundle ){
+          static const char header[ 16 ] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0', 0, 0, 0, 0, 0, 0, 0, 1 };
+          output.insert( output.end(), header, header + sizeof( header ) );
+        }
+
+        size_type encoded = 0;
+        for( size_type i = 0 ; i < count ; ++ i ){
+
+          const std :: uint32_t index = lookup( messages[ i ].address );
+          if( index == EMPTY ){
+            ++ _unknown;
+            continue;
+          }
+
+          const Entry&    entry = _entries[ index ];
+          const size_type size  = entry.size + 8;
+          size_type       at    = output.size();
+
+          output.resize( at + size + (bundle ? 4 : 0) );
+          if( bundle ){
+            store( static_cast< std :: uint32_t >( size ), output.data() + at );
+            at += 4;
+          }
+
+          std :: uint32_t bits;
+          std :: memcpy( &bits, &messages[ i ].data, sizeof( bits ) );
+          std :: memcpy( output.data() + at, _strings.data() + entry.offset, entry.size + 4 );
+          store( bits, output.data() + at + entry.size + 4 );
+          ++ encoded;
+        }
+
+        if( bundle && encoded == 0 )
+          output.clear();
+        return encoded;
+      }
+
+
+    private:
+
+      /**
+       * @brief build hash tables of registered paths
+       */
+      void build( void ){
+
+        size_type capacity = 16;
+        while( capacity < _entries.size() * 2 )
+          capacity *= 2;
+
+        _paths    .assign( capacity, static_cast< std :: uint32_t >( EMPTY ) );
+        _addresses.assign( capacity, static_cast< std :: uint32_t >( EMPTY ) );
+
+        const std :: uint32_t mask = static_cast< std :: uint32_t >( capacity - 1 );
+
+        for( std :: uint32_t i = 0 ; i < _entries.size() ; ++ i ){
+
+          // later add() of same path wins
+          const Entry&    entry = _entries[ i ];
+          std :: uint32_t slot  = entry.hash & mask;
+          for( ; _paths[ slot ] != EMPTY ; slot = (slot + 1) & mask ){
+            const Entry& other = _entries[ _paths[ slot ] ];
+            if( other.hash == entry.hash && other.size == entry.size
+                && std :: memcmp( _strings.data() + other.offset, _strings.data() + entry.offset, entry.size ) == 0 )
+              break;
+          }
+          _paths[ slot ] = i;
+        }
+
+        // Address table refers only to paths in path table, first added path of each Address
+        std :: vector< bool > alive( _entries.size(), false );
+        for( const std :: uint32_t index : _paths )
+          if( index != EMPTY )
+            alive[ index ] = true;
+
+        for( std :: uint32_t i = 0 ; i < _entries.size() ; ++ i ){
+
+          if( ! alive[ i ] )
+            continue;
+
+          std :: uint32_t slot = mix( _entries[ i ].address ) & mask;
+          for( ; _addresses[ slot ] != EMPTY ; slot = (slot + 1) & mask )
+            if( _entries[ _addresses[ slot ] ].address == _entries[ i ].address )
+              break;
+          if( _addresses[ slot ] == EMPTY )
+            _addresses[ slot ] = i;
+        }
+
+        for( Cached& cached : _cache )
+          cached = Cached{ nullptr, 0, 0 };
+
+        _dirty = false;
+      }
+
+      /**
+       * @brief Entry of an Address, EMPTY if not registered
+       */
+      std :: uint32_t lookup( const Address& address ) const {
+        const std :: uint32_t mask = static_cast< std :: uint32_t >( _addresses.size() - 1 );
+        for( std :: uint32_t slot = mix( address ) & mask ; _addresses[ slot ] != EMPTY ; slot = (slot + 1) & mask )
+          if( _entries[ _addresses[ slot ] ].address == address )
+            return _addresses[ slot ];
+        return EMPTY;
+      }
+
+
+      /**
+       * @brief decode a packet element, message or bundle
+       */
+      bool element( const char* input, const size_type length, std :: vector< Message >& output, const size_type depth ){
+
+        if( length < 4 || length % 4 != 0 )
+          return false;
+
+        if( input[ 0 ] == '/' )
+          return message( input, length, output );
+
+        if( depth >= MAX_DEPTH || length < 16 || std :: memcmp( input, "#bundle", 8 ) != 0 )
+          return false;
+
+        // time tag is ignored, messages are passed as soon as received
+        for( size_type at = 16 ; at < length ; ){
+          if( length - at < 4 )
+            return false;
+          const size_type size = load( input + at );
+          at += 4;
+          if( size > length - at || ! element( input + at, size, output, depth + 1 ) )
+            return false;
+          at += size;
+        }
+        return true;
+      }
+
+      /**
+       * @brief decode an OSC message
+       */
+      bool message( const char* input, const size_type length, std :: vector< Message >& output ){
+
+        const size_type path = string( input, length );
+        if( path == 0 || path == length )
+          return false;
+
+        const char*     tags  = input + path;
+        const size_type count = string( tags, length - path );
+        if( count == 0 || tags[ 0 ] != ',' )
+          return false;
+
+        Address address;
+        if( ! find( input, path, address ) ){
+          ++ _unknown;
+          return true;
+        }
+
+        const char*       argument = tags + count;
+        const char* const end      = input + length;
+
+        for( const char* tag = tags + 1 ; *tag != '\0' ; ++ tag, ++ address ){
+
+          size_type need = 0;
+          switch( *tag ){
+            case 'f' : case 'i' : case 'c' : case 'r' : case 'm' : need = 4; break;
+            case 'd' : case 'h' : case 't' :                       need = 8; break;
+            case 's' : case 'S' :
+              need = string( argument, static_cast< size_type >( end - argument ) );
+              if( need == 0 )
+                return false;
+              break;
+            case 'b' :
+              if( end - argument < 4 )
+                return false;
+              need = 4 + pad( load( argument ) );
+              break;
+            default : break;
+          }
+          if( need > static_cast< size_type >( end - argument ) )
+            return false;
+
+          switch( *tag ){
+            case 'f' : {
+              const std :: uint32_t bits = load( argument );
+              Data data;
+              std :: memcpy( &data, &bits, sizeof( data ) );
+              output.push_back( Message{ address, data } );
+              break;
+            }
+            case 'i' : output.push_back( Message{ address, static_cast< Data >( static_cast< std :: int32_t >( load( argument ) ) ) } ); break;
+            case 'h' : output.push_back( Message{ address, static_cast< Data >( static_cast< std :: int64_t >( load64( argument ) ) ) } ); break;
+            case 'd' : {
+              const std :: uint64_t bits = load64( argument );
+              double value;
+              std :: memcpy( &value, &bits, sizeof( value ) );
+              output.push_back( Message{ address, static_cast< Data >( value ) } );
+              break;
+            }
+            case 'T' : output.push_back( Message{ address, 1 } ); break;
+            case 'F' : output.push_back( Message{ address, 0 } ); break;
+            default  : break;
+          }
+
+          argument += need;
+        }
+
+        return true;
+      }
+
+
+      /**
+       * @brief octets of a padded OSC string including NUL and padding, 0 if not terminated in length
+       */
+      static size_type string( const char* input, const size_type length ){
+        const void* nul = std :: memchr( input, '\0', length );
+        if( nul == nullptr )
+          return 0;
+        const size_type size = pad( static_cast< size_type >( static_cast< const char* >( nul ) - input ) + 1 );
+        return size <= length ? size : 0;
+      }
+
+      /**
+       * @brief round up to multiple of 4
+       */
+      static size_type pad( const size_type size ){ return (size + 3) & ~static_cast< size_type >( 3 ); }
+
+      /**
+       * @brief hash of a padded path, by 4 octets words
+       */
+      static std :: uint32_t hash( const char* path, const size_type size ){
+        std :: uint32_t result = 0x811C9DC5UL;
+        for( size_type i = 0 ; i < size ; i += 4 ){
+          std :: uint32_t word;
+          std :: memcpy( &word, path + i, sizeof( word ) );
+          result  = (result ^ word) * 0x9E3779B1UL;
+          result ^= result >> 15;
+        }
+        return result;
+      }
+
+      /**
+       * @brief hash of an Address
+       */
+      static std :: uint32_t mix( const Address& address ){
+        const std :: uint32_t hash = static_cast< std :: uint32_t >( address * 2654435761UL );
+        return hash ^ (hash >> 16);
+      }
+
+      /**
+       * @brief load 4 octets of big endian integer
+       */
+      static std :: uint32_t load( const char* input ){
+        std :: uint32_t result;
+        std :: memcpy( &result, input, sizeof( result ) );
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        result = __builtin_bswap32( result );
+#endif
+        return result;
+      }
+
+      /**
+       * @brief load 8 octets of big endian integer
+       */
+      static std :: uint64_t load64( const char* input ){
+        std :: uint64_t result;
+        std :: memcpy( &result, input, sizeof( result ) );
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        result = __builtin_bswap64( result );
+#endif
+        return result;
+      }
+
+      /**
+       * @brief store 4 octets of big endian integer
+       */
+      static void store( std :: uint32_t value, char* output ){
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        value = __builtin_bswap32( value );
+#endif
+        std :: memcpy( output, &value, sizeof( value ) );
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_OscBridge_h */
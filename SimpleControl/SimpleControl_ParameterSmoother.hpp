@@ -0,0 +1,378 @@
+/**
+ *  @file           SimpleControl_ParameterSmoother.hpp
+ *  @brief          This class provides sample accurate parameter smoothing, renders audio rate ramps of received Data, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * | mode        | ramp to new target                                   | sequence                    |
+ * | ----------- | ---------------------------------------------------- | --------------------------- |
+ * | STEP        | jumps at the sample                                  | constant                    |
+ * | LINEAR      | reaches target after `time` seconds                  | `v + step * n`              |
+ * | EXPONENTIAL | reaches target after `time` seconds, by same ratio   | `v * ratio ^ n`             |
+ * | ONE_POLE    | approaches target with time constant `time` seconds  | `target + (v - target) * r ^ n` |
+ *
+ * Messages are scheduled with sample offset in the next block, and render() writes a block of each parameter
+ * into caller provided buffers. Scheduled changes are inserted in order into a list of fixed capacity,
+ * so neither schedule() nor render() allocates or sorts, changes over capacity are dropped. Each ramp is an arithmetic or geometric sequence,
+ * so 4 samples are computed at once with SSE, or 8 with AVX.
+ */
+
+#ifndef SimpleControlSimpleControl_ParameterSmoother_h
+#define SimpleControlSimpleControl_ParameterSmoother_h
+
+#include "SimpleControl_Types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined( __AVX__ )
+#include <immintrin.h>
+#elif defined( __SSE__ )
+#include <xmmintrin.h>
+#endif
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides smoothing of many parameters into audio rate buffers
+   *
+   * @note this class is not thread safe, call schedule() and render() from the audio thread,
+   *       or pass messages to it by a queue ( ex. SpscQueue )
+   */
+  class ParameterSmoother {
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+      /**
+       * @brief smoothing mode
+       */
+      enum Mode {
+          STEP        ///< no smoothing
+        , LINEAR      ///< linear ramp in fixed time
+        , EXPONENTIAL ///< exponential ramp in fixed time, for positive values like frequency or gain
+        , ONE_POLE    ///< one pole low pass filter
+      };
+
+    private:
+
+      /**
+       * @brief a scheduled change
+       */
+      struct Event {
+        std :: uint32_t index;  ///< index of parameter
+        std :: uint32_t offset; ///< sample offset in next block
+        Data            target; ///< new target
+      };
+
+      /**
+       * @brief state of a parameter
+       */
+      struct State {
+        Mode            mode;      ///< smoothing mode
+        Mode            shape;     ///< running ramp, STEP if value is target
+        float           time;      ///< ramp time or time constant in seconds
+        float           pole;      ///< r of ONE_POLE mode
+        float           value;     ///< current value
+        float           target;    ///< target value
+        float           delta;     ///< step ( LINEAR ), ratio ( EXPONENTIAL ) or r ( ONE_POLE ) of running ramp
+        std :: uint32_t remaining; ///< samples until target ( LINEAR, EXPONENTIAL )
+      };
+
+      float                  _sample_rate; ///< samples per second
+      Address                _first;       ///< Address of parameter 0
+      std :: vector< State > _states;      ///< parameters
+      std :: vector< Event > _events;      ///< scheduled changes of next block, by index and offset
+      size_type              _capacity;    ///< maximum scheduled changes of a block
+      std :: uint64_t        _dropped;     ///< number of changes dropped by full list
+
+    public:
+
+      /**
+       * @brief constructor, all parameters are STEP mode and 0
+       *
+       * @param[in] count         number of parameters
+       * @param[in] sample_rate   samples per second
+       * @param[in] first         Address of parameter 0, parameter index is `address - first`
+       * @param[in] capacity      maximum scheduled changes of a block, 0 is 4 per parameter
+       */
+      ParameterSmoother( const size_type count, const float sample_rate, const Address& first = 0, const size_type capacity = 0 ) :
+          _sample_rate( sample_rate )
+        , _first( first )
+        , _states( count, State{ STEP, STEP, 0, 0, 0, 0, 0, 0 } )
+        , _events()
+        , _capacity( capacity != 0 ? capacity : count * 4 )
+        , _dropped( 0 )
+      {
+        _events.reserve( _capacity );
+      }
+
+
+      size_type       size    ( void ) const { return _states.size(); } ///< number of parameters
+      size_type       capacity( void ) const { return _capacity; }      ///< maximum scheduled changes of a block
+      std :: uint64_t dropped ( void ) const { return _dropped; }       ///< number of changes dropped by full list
+
+      float value( const size_type index ) const { return _states[ index ].value; } ///< current value of parameter
+
+
+      /**
+       * @brief set smoothing mode of a parameter, applied from next target
+       *
+       * @param[in] index   index of parameter
+       * @param[in] mode    smoothing mode
+       * @param[in] time    ramp time ( LINEAR, EXPONENTIAL ) or time constant ( ONE_POLE ) in seconds, 0 is same as STEP
+       */
+      void mode( const size_type index, const Mode mode, const float time ){
+        State& state = _states[ index ];
+        state.mode = mode;
+        state.time = time > 0 ? time : 0;
+        state.pole = time > 0 ? std :: exp( -1.0f / (time * _sample_rate) ) : 0;
+      }
+
+      /**
+       * @brief set value immediately, without smoothing
+       */
+      void reset( const size_type index, const float value ){
+        State& state = _states[ index ];
+        state.shape     = STEP;
+        state.value     = value;
+        state.target    = value;
+        state.remaining = 0;
+      }
+
+
+      /**
+       * @brief schedule new target of a parameter
+       *
+       * @param[in] index   index of parameter
+       * @param[in] target  new target
+       * @param[in] offset  sample offset in next block, later than block size means the end of block
+       * @return            false if index is out of range, or scheduled changes are full and the change is dropped
+       */
+      bool schedule( const size_type index, const Data& target, const std :: uint32_t offset = 0 ){
+
+        if( index >= _states.size() )
+          return false;
+
+        if( _events.size() == _capacity ){
+          ++ _dropped;
+          return false;
+        }
+
+        // changes of same offset keep order of schedule. insert doesn't allocate under capacity
+        std :: vector< Event > :: iterator position = _events.end();
+        while( position != _events.begin()
+            && (index < (position - 1) -> index || (index == (position - 1) -> index && offset < (position - 1) -> offset)) )
+          -- position;
+
+        _events.insert( position, Event{ static_cast< std :: uint32_t >( index ), offset, target } );
+        return true;
+      }
+
+      /**
+       * @brief schedule a decoded message, parameter index is `address - first`
+       *
+       * @param[in] message   decoded message
+       * @param[in] offset    sample offset in next block
+       * @return              false if Address is out of range, or scheduled changes are full
+       */
+      bool schedule( const Message& message, const std :: uint32_t offset = 0 ){
+        return message.address >= _first && schedule( static_cast< size_type >( message.address - _first ), message.data, offset );
+      }
+
+
+      /**
+       * @brief render a block of all parameters
+       *
+       * @param[out]  outputs   buffer of each parameter, `outputs[ i ]` requires frames samples, nullptr to skip
+       * @param[in]   frames    samples of the block
+       */
+      void render( float* const* outputs, const size_type frames ){
+
+        std :: vector< Event > :: const_iterator event = _events.begin();
+
+        for( size_type index = 0 ; index < _states.size() ; ++ index ){
+
+          State& state  = _states[ index ];
+          float* output = outputs[ index ];
+          size_type done = 0;
+
+          for( ; event != _events.end() && event -> index == index ; ++ event ){
+            const size_type offset = std :: min< size_type >( event -> offset, frames );
+            advance( state, output, done, offset );
+            start( state, event -> target );
+            done = offset;
+          }
+
+          advance( state, output, done, frames );
+        }
+
+        _events.clear();
+      }
+
+
+    private:
+
+      /**
+       * @brief start ramp to new target
+       */
+      void start( State& state, const float target ) const {
+
+        const std :: uint32_t samples = static_cast< std :: uint32_t >( state.time * _sample_rate + 0.5f );
+
+        state.target    = target;
+        state.shape     = STEP;
+        state.remaining = 0;
+
+        if( samples == 0 || target == state.value || state.mode == STEP ){
+          state.value = target;
+          return;
+        }
+
+        if( state.mode == ONE_POLE ){
+          state.shape = ONE_POLE;
+          state.delta = state.pole;
+          return;
+        }
+
+        // no exponential ramp across 0, use linear one
+        if( state.mode == EXPONENTIAL && state.value * target > 0 ){
+          state.shape = EXPONENTIAL;
+          state.delta = std :: pow( target / state.value, 1.0f / static_cast< float >( samples ) );
+        }
+        else {
+          state.shape = LINEAR;
+          state.delta = (target - state.value) / static_cast< float >( samples );
+        }
+        state.remaining = samples;
+      }
+
+      /**
+       * @brief render samples `[ begin, end )` of a parameter
+       */
+      static void advance( State& state, float* output, size_type begin, const size_type end ){
+
+        if( begin >= end )
+          return;
+
+        switch( state.shape ){
+          case ONE_POLE :
+            state.value = geometric( output, begin, end, state.target, state.value - state.target, state.delta );
+            if( std :: fabs( state.value - state.target ) <= std :: fabs( state.target ) * 1e-6f + 1e-9f ){
+              state.value = state.target;
+              state.shape = STEP;
+            }
+            return;
+
+          case LINEAR :
+          case EXPONENTIAL : {
+            const size_type n = std :: min< size_type >( state.remaining, end - begin );
+
+            state.value = state.shape == LINEAR ? arithmetic( output, begin, begin + n, state.value, state.delta )
+                                                : geometric ( output, begin, begin + n, 0, state.value, state.delta );
+
+            state.remaining -= static_cast< std :: uint32_t >( n );
+            begin           += n;
+
+            if( state.remaining == 0 ){
+              state.value = state.target;
+              state.shape = STEP;
+            }
+            break;
+          }
+
+          case STEP :
+            break;
+        }
+
+        if( output != nullptr )
+          std :: fill( output + begin, output + end, state.value );
+      }
+
+      /**
+       * @brief write `value + step * k` for k = 1, 2, ...
+       *
+       * @return  last value
+       */
+      static float arithmetic( float* output, size_type begin, const size_type end, const float value, const float step ){
+
+        if( output != nullptr ){
+#if defined( __AVX__ )
+          const __m256 steps = _mm256_set_ps( 8 * step, 7 * step, 6 * step, 5 * step, 4 * step, 3 * step, 2 * step, step );
+          const __m256 jump  = _mm256_set1_ps( 8 * step );
+          __m256       base  = _mm256_set1_ps( value );
+          size_type    k     = begin;
+          for( ; k + 8 <= end ; k += 8 ){
+            _mm256_storeu_ps( output + k, _mm256_add_ps( base, steps ) );
+            base = _mm256_add_ps( base, jump );
+          }
+          for( ; k < end ; ++ k )
+            output[ k ] = value + step * static_cast< float >( k - begin + 1 );
+#elif defined( __SSE__ )
+          const __m128 steps = _mm_set_ps( 4 * step, 3 * step, 2 * step, step );
+          const __m128 jump  = _mm_set1_ps( 4 * step );
+          __m128       base  = _mm_set1_ps( value );
+          size_type    k     = begin;
+          for( ; k + 4 <= end ; k += 4 ){
+            _mm_storeu_ps( output + k, _mm_add_ps( base, steps ) );
+            base = _mm_add_ps( base, jump );
+          }
+          for( ; k < end ; ++ k )
+            output[ k ] = value + step * static_cast< float >( k - begin + 1 );
+#else
+          for( size_type k = begin ; k < end ; ++ k )
+            output[ k ] = value + step * static_cast< float >( k - begin + 1 );
+#endif
+        }
+
+        return value + step * static_cast< float >( end - begin );
+      }
+
+      /**
+       * @brief write `offset + scale * ratio ^ k` for k = 1, 2, ...
+       *
+       * @return  last value
+       */
+      static float geometric( float* output, size_type begin, const size_type end, const float offset, const float scale, const float ratio ){
+
+        const size_type n = end - begin;
+
+        if( output != nullptr ){
+#if defined( __SSE__ )
+          const float r2 = ratio * ratio;
+          const float r4 = r2 * r2;
+          const __m128 add  = _mm_set1_ps( offset );
+          const __m128 jump = _mm_set1_ps( r4 );
+          __m128       term = _mm_mul_ps( _mm_set1_ps( scale ), _mm_set_ps( r4, r2 * ratio, r2, ratio ) );
+          size_type    k    = begin;
+          for( ; k + 4 <= end ; k += 4 ){
+            _mm_storeu_ps( output + k, _mm_add_ps( add, term ) );
+            term = _mm_mul_ps( term, jump );
+          }
+          float rest[ 4 ];
+          _mm_storeu_ps( rest, term );
+          for( size_type lane = 0 ; k < end ; ++ k, ++ lane )
+            output[ k ] = offset + rest[ lane ];
+#else
+          float term = scale;
+          for( size_type k = begin ; k < end ; ++ k ){
+            term       *= ratio;
+            output[ k ] = offset + term;
+          }
+#endif
+        }
+
+        return offset + scale * std :: pow( ratio, static_cast< float >( n ) );
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_ParameterSmoother_h */
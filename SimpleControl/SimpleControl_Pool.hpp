@@ -0,0 +1,521 @@
+/**
+ *  @file           SimpleControl_Pool.hpp
+ *  @brief          This class provides fixed capacity object pool and bump arena, for messages and frame buffers in flight, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * * Pool
+ *     * all objects are allocated at construction, shared by threads
+ *     * each thread keeps a small cache of free objects, so acquire / release don't touch shared list in most cases
+ *     * when a cache is full or empty, half of cache is moved from / to shared list at once
+ *     * when shared list is also empty, free objects in caches of other threads are taken before acquire() fails,
+ *       so objects released by a consumer thread are reused by a producer thread ( ex. Serialized_ReceivePipeline )
+ * * Arena
+ *     * bump allocator for transient batches, reset() at the end of each tick frees everything at once
+ *
+ * Both keep allocation statistics. Nothing calls `malloc` after construction.
+ */
+
+#ifndef SimpleControlSimpleControl_Pool_h
+#define SimpleControlSimpleControl_Pool_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief allocation statistics of Pool / Arena
+   */
+  struct PoolStatistics {
+    std :: uint64_t allocated; ///< number of successful allocations
+    std :: uint64_t released;  ///< number of released objects
+    std :: uint64_t failed;    ///< number of allocations failed by exhaustion
+    std :: size_t   in_use;    ///< objects ( Pool ) or octets ( Arena ) in use now
+    std :: size_t   peak;      ///< maximum of in_use
+  };
+
+
+  /**
+   * @brief this class provides fixed capacity object pool with thread local cache
+   *
+   * @note objects must be released before the pool is destructed
+   *
+   * @tparam    T       object type
+   * @tparam    CACHE   maximum free objects cached by each thread
+   */
+  template < typename T, std :: size_t CACHE = 32 >
+  class Pool {
+
+    static_assert( CACHE >= 2, "Pool CACHE must be 2 or more" );
+
+    public:
+      using value_type = T;             ///< object type
+      using size_type  = std :: size_t; ///< size type
+
+    private:
+
+      /**
+       * @brief storage of an object, next is used while the slot is free
+       */
+      union Slot {
+        Slot*                      next;                 ///< next free slot
+        alignas( T ) unsigned char storage[ sizeof( T ) ]; ///< object storage
+      };
+
+      /**
+       * @brief free slots cached by a thread
+       *
+       * slots and size are guarded by busy, the owner thread locks it, other threads only try to lock it
+       */
+      struct Cache {
+        Pool*                 owner;          ///< pool of cached slots, nullptr if unused
+        std :: uint64_t       generation;     ///< generation of owner, to detect reused address
+        Cache*                next;           ///< next cache of owner, guarded by owner's _mutex
+        std :: atomic< bool > busy;           ///< spin lock of slots and size
+        Slot*                 slots[ CACHE ]; ///< cached slots
+        size_type             size;           ///< number of cached slots
+      };
+
+      /**
+       * @brief caches of a thread, cached slots are returned to live pools at thread exit
+       */
+      struct Caches {
+        constexpr static size_type ENTRIES = 4; ///< pools of this type cached by a thread at once
+        Cache     entries[ ENTRIES ];           ///< cache entries
+        size_type victim;                       ///< next entry to reuse when all entries are used
+
+        ~Caches( void ){
+          for( Cache& cache : entries )
+            give_back( cache );
+        }
+      };
+
+      std :: unique_ptr< Slot[] > _slots;      ///< all slots
+      size_type                   _capacity;   ///< number of slots
+      std :: uint64_t             _generation; ///< unique number of this pool
+
+      std :: mutex _mutex;  ///< guard of _free and _caches
+      Slot*        _free;   ///< shared list of free slots
+      Cache*       _caches; ///< caches of threads for this pool
+
+      std :: atomic< std :: uint64_t > _allocated; ///< number of successful allocations
+      std :: atomic< std :: uint64_t > _released;  ///< number of released objects
+      std :: atomic< std :: uint64_t > _failed;    ///< number of failed allocations
+      std :: atomic< size_type >       _in_use;    ///< number of objects in use
+      std :: atomic< size_type >       _peak;      ///< maximum of objects in use
+
+    public:
+
+      /**
+       * @brief constructor, allocates all slots
+       *
+       * @param[in] capacity  number of objects
+       */
+      explicit Pool( const size_type capacity ) :
+          _slots( new Slot[ capacity ] )
+        , _capacity( capacity )
+        , _generation( next_generation() )
+        , _mutex()
+        , _free( nullptr )
+        , _caches( nullptr )
+        , _allocated( 0 )
+        , _released( 0 )
+        , _failed( 0 )
+        , _in_use( 0 )
+        , _peak( 0 )
+      {
+        for( size_type i = capacity ; i != 0 ; -- i ){
+          _slots[ i - 1 ].next = _free;
+          _free = &_slots[ i - 1 ];
+        }
+
+        std :: lock_guard< std :: mutex > lock( registry_mutex() );
+        registry().push_back( this );
+      }
+
+      /**
+       * @brief destructor, slots cached by other threads are forgotten
+       */
+      ~Pool( void ){
+        std :: lock_guard< std :: mutex > lock( registry_mutex() );
+        std :: vector< Pool* >& pools = registry();
+        for( size_type i = 0 ; i < pools.size() ; ++ i )
+          if( pools[ i ] == this ){
+            pools[ i ] = pools.back();
+            pools.pop_back();
+            break;
+          }
+      }
+
+      Pool( const Pool& ) = delete;
+      Pool& operator= ( const Pool& ) = delete;
+
+
+      /**
+       * @brief number of objects
+       */
+      size_type capacity( void ) const { return _capacity; }
+
+
+      /**
+       * @brief construct an object in the pool
+       *
+       * @param[in] args  arguments of constructor of T
+       * @return          pointer to constructed object, nullptr if the pool is exhausted
+       */
+      template < typename... Args >
+      T* acquire( Args&&... args ){
+
+        Cache& cache = local();
+        lock( cache );
+
+        if( cache.size == 0 )
+          refill( cache );
+
+        if( cache.size == 0 ){
+          unlock( cache );
+          _failed.fetch_add( 1, std :: memory_order_relaxed );
+          return nullptr;
+        }
+
+        Slot* slot = cache.slots[ -- cache.size ];
+        unlock( cache );
+
+        T* item = new ( slot -> storage ) T( std :: forward< Args >( args )... );
+
+        _allocated.fetch_add( 1, std :: memory_order_relaxed );
+        const size_type in_use = _in_use.fetch_add( 1, std :: memory_order_relaxed ) + 1;
+        size_type       peak   = _peak.load( std :: memory_order_relaxed );
+        while( in_use > peak && ! _peak.compare_exchange_weak( peak, in_use, std :: memory_order_relaxed ) )
+          ;
+
+        return item;
+      }
+
+      /**
+       * @brief destruct an object and return it to the pool
+       *
+       * @param[in] item  object acquired from this pool, nullptr is ignored
+       */
+      void release( T* item ){
+
+        if( item == nullptr )
+          return;
+
+        item -> ~T();
+
+        Cache& cache = local();
+        lock( cache );
+
+        if( cache.size == CACHE )
+          drain( cache );
+
+        cache.slots[ cache.size ++ ] = reinterpret_cast< Slot* >( item );
+        unlock( cache );
+
+        _released.fetch_add( 1, std :: memory_order_relaxed );
+        _in_use  .fetch_sub( 1, std :: memory_order_relaxed );
+      }
+
+
+      /**
+       * @brief allocation statistics
+       */
+      PoolStatistics statistics( void ) const {
+        return PoolStatistics{
+            _allocated.load( std :: memory_order_relaxed )
+          , _released .load( std :: memory_order_relaxed )
+          , _failed   .load( std :: memory_order_relaxed )
+          , _in_use   .load( std :: memory_order_relaxed )
+          , _peak     .load( std :: memory_order_relaxed )
+        };
+      }
+
+
+    private:
+
+      /**
+       * @brief unique number for each pool, cache entries of destructed pools are not reused
+       */
+      static std :: uint64_t next_generation( void ){
+        static std :: atomic< std :: uint64_t > generation( 0 );
+        return ++ generation;
+      }
+
+      /**
+       * @brief live pools of this type
+       */
+      static std :: vector< Pool* >& registry( void ){
+        static std :: vector< Pool* > pools;
+        return pools;
+      }
+
+      /**
+       * @brief guard of registry(), held while slots are returned to a pool from other threads
+       */
+      static std :: mutex& registry_mutex( void ){
+        static std :: mutex mutex;
+        return mutex;
+      }
+
+      /**
+       * @brief spin lock of a cache
+       */
+      static void lock( Cache& cache ){
+        while( cache.busy.exchange( true, std :: memory_order_acquire ) )
+          std :: this_thread :: yield();
+      }
+
+      /**
+       * @brief try spin lock of a cache
+       *
+       * @return false if the cache is locked by other thread
+       */
+      static bool try_lock( Cache& cache ){
+        return ! cache.busy.exchange( true, std :: memory_order_acquire );
+      }
+
+      /**
+       * @brief unlock spin lock of a cache
+       */
+      static void unlock( Cache& cache ){
+        cache.busy.store( false, std :: memory_order_release );
+      }
+
+
+      /**
+       * @brief return cached slots to their pool if it is still alive, and clear the cache entry
+       *
+       * @note called by the thread of the cache
+       */
+      static void give_back( Cache& cache ){
+
+        if( cache.owner != nullptr ){
+          std :: lock_guard< std :: mutex > lock( registry_mutex() );
+          for( Pool* pool : registry() )
+            if( pool == cache.owner && pool -> _generation == cache.generation ){
+              std :: lock_guard< std :: mutex > guard( pool -> _mutex );
+
+              for( Cache** link = &pool -> _caches ; *link != nullptr ; link = &(*link) -> next )
+                if( *link == &cache ){
+                  *link = cache.next;
+                  break;
+                }
+
+              Pool :: lock( cache );
+              while( cache.size != 0 ){
+                Slot* slot = cache.slots[ -- cache.size ];
+                slot -> next = pool -> _free;
+                pool -> _free = slot;
+              }
+              Pool :: unlock( cache );
+              break;
+            }
+        }
+
+        cache.owner = nullptr;
+        cache.next  = nullptr;
+        cache.size  = 0;
+      }
+
+      /**
+       * @brief cache of this thread for this pool
+       *
+       * each thread has a few cache entries per pool type, entries are assigned to pools in first use
+       */
+      Cache& local( void ){
+
+        thread_local Caches caches = {};
+
+        Cache* victim = nullptr;
+        for( Cache& cache : caches.entries ){
+          if( cache.owner == this && cache.generation == _generation )
+            return cache;
+          if( victim == nullptr && cache.owner == nullptr )
+            victim = &cache;
+        }
+
+        if( victim == nullptr ){
+          victim = &caches.entries[ caches.victim ];
+          caches.victim = (caches.victim + 1) % Caches :: ENTRIES;
+          give_back( *victim );
+        }
+
+        victim -> owner      = this;
+        victim -> generation = _generation;
+        victim -> size       = 0;
+
+        std :: lock_guard< std :: mutex > lock( _mutex );
+        victim -> next = _caches;
+        _caches        = victim;
+        return *victim;
+      }
+
+      /**
+       * @brief move half of cache size from shared list to cache,
+       *        or take slots from caches of other threads if shared list is empty
+       *
+       * a cache locked by its owner is skipped, and tried again after _mutex is released,
+       * because the owner may be waiting for _mutex.
+       *
+       * @note called with the cache locked
+       */
+      void refill( Cache& cache ){
+
+        for( size_type round = 0 ; round < CACHE ; ++ round ){
+
+          bool skipped = false;
+          {
+            std :: lock_guard< std :: mutex > lock( _mutex );
+
+            while( cache.size < CACHE / 2 && _free != nullptr ){
+              cache.slots[ cache.size ++ ] = _free;
+              _free = _free -> next;
+            }
+
+            if( cache.size != 0 )
+              return;
+
+            for( Cache* other = _caches ; other != nullptr && cache.size < CACHE / 2 ; other = other -> next ){
+              if( other == &cache )
+                continue;
+              if( ! try_lock( *other ) ){
+                skipped = true;
+                continue;
+              }
+              while( other -> size != 0 && cache.size < CACHE / 2 )
+                cache.slots[ cache.size ++ ] = other -> slots[ -- other -> size ];
+              unlock( *other );
+            }
+          }
+
+          if( cache.size != 0 || ! skipped )
+            return;
+
+          std :: this_thread :: yield();
+        }
+      }
+
+      /**
+       * @brief move half of cache to shared list
+       *
+       * @note called with the cache locked
+       */
+      void drain( Cache& cache ){
+        std :: lock_guard< std :: mutex > lock( _mutex );
+        while( cache.size > CACHE / 2 ){
+          Slot* slot = cache.slots[ -- cache.size ];
+          slot -> next = _free;
+          _free = slot;
+        }
+      }
+
+  };
+
+
+
+  /**
+   * @brief this class provides bump allocator, all allocations are freed at once by reset()
+   *
+   * @note this class is not thread safe, use one arena per thread
+   */
+  class Arena {
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+    private:
+      std :: unique_ptr< unsigned char[] > _buffer;   ///< memory block
+      size_type                            _capacity; ///< octets of memory block
+      size_type                            _used;     ///< octets in use
+      PoolStatistics                       _statistics; ///< allocation statistics
+
+    public:
+
+      /**
+       * @brief constructor, allocates memory block
+       *
+       * @param[in] capacity  octets of memory block
+       */
+      explicit Arena( const size_type capacity ) :
+          _buffer( new unsigned char[ capacity ] )
+        , _capacity( capacity )
+        , _used( 0 )
+        , _statistics()
+      {}
+
+      Arena( const Arena& ) = delete;
+      Arena& operator= ( const Arena& ) = delete;
+
+
+      size_type capacity( void ) const { return _capacity; }                 ///< octets of memory block
+      size_type used    ( void ) const { return _used; }                     ///< octets in use
+      const PoolStatistics& statistics( void ) const { return _statistics; } ///< allocation statistics
+
+
+      /**
+       * @brief allocate raw memory
+       *
+       * @param[in] size        octets to allocate
+       * @param[in] alignment   alignment, power of 2
+       * @return                pointer to memory, nullptr if arena is exhausted
+       */
+      void* allocate( const size_type size, const size_type alignment = alignof( std :: max_align_t ) ){
+
+        const std :: uintptr_t base  = reinterpret_cast< std :: uintptr_t >( _buffer.get() );
+        const std :: uintptr_t start = (base + _used + alignment - 1) & ~static_cast< std :: uintptr_t >( alignment - 1 );
+        const size_type        end   = static_cast< size_type >( start - base ) + size;
+
+        if( end > _capacity ){
+          ++ _statistics.failed;
+          return nullptr;
+        }
+
+        _used = end;
+        ++ _statistics.allocated;
+        _statistics.in_use = _used;
+        if( _used > _statistics.peak )
+          _statistics.peak = _used;
+
+        return reinterpret_cast< void* >( start );
+      }
+
+      /**
+       * @brief allocate array of trivially destructible type, elements are not initialized
+       *
+       * @tparam    T       element type
+       * @param[in] count   number of elements
+       * @return            pointer to first element, nullptr if arena is exhausted
+       */
+      template < typename T >
+      T* allocate_array( const size_type count ){
+        static_assert( std :: is_trivially_destructible< T > :: value, "Arena never calls destructors" );
+        return static_cast< T* >( allocate( sizeof( T ) * count, alignof( T ) ) );
+      }
+
+      /**
+       * @brief free all allocations, call at the end of each tick
+       */
+      void reset( void ){
+        _statistics.released += _statistics.allocated - _statistics.released;
+        _statistics.in_use    = 0;
+        _used                 = 0;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_Pool_h */
@@ -0,0 +1,216 @@
+/**
+ *  @file           SimpleControl_RateLimiter.hpp
+ *  @brief          This class provides per Address token bucket rate limiter for send path.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Each bucket allows `rate` messages per second with bursts up to `burst` messages.
+ * Buckets are kept in a flat open addressing table, keyed by `address >> range_shift`,
+ * so Addresses which have same upper bits share a bucket.
+ *
+ * A bucket is stored as its theoretical arrival time ( GCRA ), one 32 bit time per bucket.
+ * A message passes when the time is not later than `now + (burst - 1) * interval`,
+ * then the time is advanced by `interval = 1 / rate`.
+ * Interval is whole microseconds, the remainder of `1000000 / rate` is carried between messages, so the average rate is exact.
+ * Rates over MAX_RATE are limited to MAX_RATE.
+ *
+ * A bucket whose time is already past is same as a full bucket, so its slot is reused for other keys.
+ * When the table is crowded, a new key takes over a bucket with its remaining time,
+ * and the evicted key starts with a full bucket when it comes back. evicted() counts them, keep CAPACITY over active keys.
+ *
+ * Call admit() before encode, and send the message only when it returns `PASS`.
+ */
+
+#ifndef SimpleControlSimpleControl_RateLimiter_h
+#define SimpleControlSimpleControl_RateLimiter_h
+
+#include "SimpleControl_Types.hpp"
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides per Address token bucket rate limiter
+   *
+   * @tparam    CAPACITY    number of buckets, power of 2
+   */
+  template < unsigned int CAPACITY = 64 >
+  class RateLimiter {
+
+    static_assert( CAPACITY != 0 && (CAPACITY & (CAPACITY - 1)) == 0, "RateLimiter CAPACITY must be power of 2" );
+
+    public:
+
+      constexpr static uint32_t MAX_RATE = 1000000; ///< maximum messages per second of a bucket, interval of 1 microsecond
+
+      /**
+       * @brief result of admit()
+       */
+      enum Verdict {
+          PASS  ///< send the message
+        , DEFER ///< bucket is empty, send the message later
+        , DROP  ///< bucket is empty, discard the message
+      };
+
+    private:
+      constexpr static unsigned int PROBE = CAPACITY < 4 ? CAPACITY : 4; ///< slots searched for a key
+
+      /**
+       * @brief a token bucket
+       */
+      struct Bucket {
+        Address  key;  ///< `address >> range_shift`
+        uint32_t time; ///< theoretical arrival time of next message in microseconds
+        bool     used; ///< true if key is valid
+      };
+
+      Bucket        _buckets[ CAPACITY ]; ///< flat table of buckets
+      uint32_t      _rate;                ///< messages per second, 1 to MAX_RATE
+      uint32_t      _interval;            ///< whole microseconds per token
+      uint32_t      _remainder;           ///< `1000000 % rate`, carried by _carry
+      uint32_t      _carry;               ///< accumulated remainder, a microsecond is added when it reaches rate
+      uint32_t      _window;              ///< microseconds of burst, `(burst - 1) / rate`
+      unsigned char _range_shift;         ///< lower bits of Address ignored by key
+      bool          _drop;                ///< true if excess messages are dropped instead of deferred
+
+      uint32_t _passed;   ///< number of passed messages
+      uint32_t _deferred; ///< number of deferred messages
+      uint32_t _dropped;  ///< number of dropped messages
+      uint32_t _evicted;  ///< number of buckets taken over by other keys
+
+    public:
+
+      /**
+       * @brief constructor
+       *
+       * @param[in] rate          messages per second of each bucket, 1 to MAX_RATE, limited to the range
+       * @param[in] burst         messages sent at once from a full bucket, 1 or more
+       * @param[in] range_shift   Addresses which have same `address >> range_shift` share a bucket, 0 for per Address
+       * @param[in] drop          true to drop excess messages, false to defer
+       */
+      RateLimiter( const uint32_t rate, const uint32_t burst = 1, const unsigned char range_shift = 0, const bool drop = false ) :
+          _buckets()
+        , _rate( rate == 0 ? 1 : rate > MAX_RATE ? MAX_RATE : rate )
+        , _interval( 1000000UL / _rate )
+        , _remainder( 1000000UL % _rate )
+        , _carry( 0 )
+        , _window( window( burst, _rate ) )
+        , _range_shift( range_shift )
+        , _drop( drop )
+        , _passed( 0 )
+        , _deferred( 0 )
+        , _dropped( 0 )
+        , _evicted( 0 )
+      {}
+
+
+      uint32_t passed  ( void ) const { return _passed;   } ///< number of passed messages
+      uint32_t deferred( void ) const { return _deferred; } ///< number of deferred messages
+      uint32_t dropped ( void ) const { return _dropped;  } ///< number of dropped messages
+      uint32_t evicted ( void ) const { return _evicted;  } ///< number of buckets taken over by other keys
+
+
+      /**
+       * @brief forget all buckets and counters
+       */
+      void clear( void ){
+        for( unsigned int i = 0 ; i < CAPACITY ; ++ i )
+          _buckets[ i ].used = false;
+        _passed = _deferred = _dropped = _evicted = 0;
+        _carry  = 0;
+      }
+
+
+      /**
+       * @brief take a token for a message
+       *
+       * @param[in] address   Address of the message
+       * @param[in] now       current time in microseconds, wrap around is allowed ( ex. `micros()` on Arduino )
+       * @return              `PASS` if the message can be sent, otherwise `DEFER` or `DROP`
+       */
+      Verdict admit( const Address& address, const uint32_t now ){
+
+        Bucket& bucket = find( address >> _range_shift, now );
+
+        if( static_cast< int32_t >( bucket.time - now ) < 0 )
+          bucket.time = now;
+
+        if( static_cast< int32_t >( bucket.time - now ) > static_cast< int32_t >( _window ) ){
+          if( _drop ){
+            ++ _dropped;
+            return DROP;
+          }
+          ++ _deferred;
+          return DEFER;
+        }
+
+        _carry += _remainder;
+        if( _carry >= _rate ){
+          _carry      -= _rate;
+          bucket.time += 1;
+        }
+        bucket.time += _interval;
+        ++ _passed;
+        return PASS;
+      }
+
+
+    private:
+
+      /**
+       * @brief microseconds of burst, limited to half of 32 bits time
+       *
+       * @param[in] burst   messages sent at once from a full bucket
+       * @param[in] rate    messages per second, 1 to MAX_RATE
+       */
+      static uint32_t window( const uint32_t burst, const uint32_t rate ){
+        const uint64_t result = (burst == 0 ? 0 : static_cast< uint64_t >( burst - 1 )) * 1000000UL / rate;
+        return result > 0x7FFFFFFFUL ? 0x7FFFFFFFUL : static_cast< uint32_t >( result );
+      }
+
+      /**
+       * @brief find bucket of key, or take a free slot
+       *
+       * slots of unused or full buckets are free. when no slot is free, first slot of the key is taken over
+       * with its remaining time, so the new key gets no extra tokens, but the evicted key starts full when it comes back.
+       *
+       * @param[in] key   `address >> range_shift`
+       * @param[in] now   current time in microseconds
+       * @return          bucket of the key
+       */
+      Bucket& find( const Address key, const uint32_t now ){
+
+        const uint32_t     hash = static_cast< uint32_t >( key * 2654435761UL );
+        const unsigned int home = static_cast< unsigned int >( hash ^ (hash >> 16) ) & (CAPACITY - 1);
+
+        Bucket* free = nullptr;
+
+        for( unsigned int i = 0 ; i < PROBE ; ++ i ){
+          Bucket& bucket = _buckets[ (home + i) & (CAPACITY - 1) ];
+
+          if( bucket.used && bucket.key == key )
+            return bucket;
+
+          if( free == nullptr && ( ! bucket.used || static_cast< int32_t >( bucket.time - now ) <= 0 ) )
+            free = &bucket;
+        }
+
+        if( free == nullptr ){
+          ++ _evicted;
+          _buckets[ home ].key = key;
+          return _buckets[ home ];
+        }
+
+        free -> key  = key;
+        free -> time = now;
+        free -> used = true;
+        return *free;
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_RateLimiter_h */
@@ -0,0 +1,308 @@
+/**
+ *  @file           SimpleControl_Schema.hpp
+ *  @brief          This class provides compile time parameter schema, static dispatch of messages to handlers by Address.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * A schema is a `constexpr` table of parameters, declared as a static member `parameters` of a definition type.
+ *
+ * @code
+ * struct Synth {
+ *   constexpr static SimpleControl :: Schema :: Parameter parameters[] = {
+ *       { 0x10, SimpleControl :: Schema :: Payload :: DATA,         0,     1, &on_gain   }
+ *     , { 0x11, SimpleControl :: Schema :: Payload :: QUANTIZED_14, 20, 20000, &on_cutoff }
+ *   };
+ * };
+ * constexpr SimpleControl :: Schema :: Parameter Synth :: parameters[];
+ *
+ * using SynthSchema = SimpleControl :: Schema :: Dispatcher< Synth >;
+ * @endcode
+ *
+ * Dispatcher builds a dense table indexed by `address - FIRST` at compile time,
+ * so dispatch() is a bounds check and an indexed call.
+ * Duplicate Addresses, Addresses over the dense table limit, minimum over maximum and null handlers are compile errors.
+ * Address frame of each parameter, with the kind of its payload, is encoded at compile time.
+ *
+ * This file requires C++14, the schema is empty before it.
+ */
+
+#ifndef SimpleControlSimpleControl_Schema_h
+#define SimpleControlSimpleControl_Schema_h
+
+#include "SimpleControl_Types.hpp"
+#include "Serialized.hpp"
+#include "Serialized_Quantized.hpp"
+
+#if __cplusplus >= 201402L
+
+namespace SimpleControl {
+
+  /**
+   * @brief compile time parameter schema and its types
+   */
+  namespace Schema {
+
+    /**
+     * @brief kind of frame following Address frame of a parameter
+     */
+    enum class Payload : uint8_t {
+        DATA          ///< plain Data frame
+      , QUANTIZED_14  ///< Serialized_Quantized< 14 > frame
+      , QUANTIZED_21  ///< Serialized_Quantized< 21 > frame
+    };
+
+    /**
+     * @brief handler of a parameter, called with Data clamped to the range of parameter
+     */
+    using Handler = void (*)( const Data data );
+
+    /**
+     * @brief a parameter of schema
+     */
+    struct Parameter {
+      Address address; ///< Address of parameter
+      Payload payload; ///< kind of frame following Address frame
+      Data    minimum; ///< minimum Data, Data of quantized value 0
+      Data    maximum; ///< maximum Data, Data of maximum quantized value
+      Handler handler; ///< handler of parameter
+    };
+
+
+    /**
+     * @brief this class provides static dispatch of a compile time parameter schema
+     *
+     * @tparam    Definition    type which has `constexpr static Parameter parameters[]`
+     * @tparam    MAX_SPAN      maximum number of entries of dense table, from lowest to highest Address
+     */
+    template < typename Definition, Address MAX_SPAN = 256 >
+    class Dispatcher {
+
+      public:
+        using value_type = Serialized :: value_type; ///< serial data value type, same as Serialized
+        using size_type  = Serialized :: size_type;  ///< serial data size type, same as Serialized
+
+        /**
+         * @brief Address frame encoded at compile time
+         */
+        struct Frame {
+          value_type octets[ Serialized :: SIZE ]; ///< encoded octets
+
+          const value_type* begin( void ) const { return octets; }                      ///< first octet
+          const value_type* end  ( void ) const { return octets + Serialized :: SIZE; } ///< end of octets
+        };
+
+      private:
+        constexpr static value_type header_bit = 0b10000000;
+
+        /**
+         * @brief an entry of dense table
+         */
+        struct Slot {
+          Handler  handler;  ///< handler, nullptr if no parameter has this Address
+          Data     minimum;  ///< minimum Data
+          Data     maximum;  ///< maximum Data
+          Payload  payload;  ///< kind of following frame
+          Quantize quantize; ///< mapping of quantized value
+          Frame    frame;    ///< encoded Address frame
+        };
+
+        /**
+         * @brief dense table, indexed by `address - FIRST`
+         */
+        template < Address N >
+        struct Table {
+          Slot slots[ N ]; ///< entries
+        };
+
+
+        constexpr static size_type COUNT = sizeof( Definition :: parameters ) / sizeof( Parameter ); ///< number of parameters
+
+        constexpr static Address first( void ){
+          Address result = Definition :: parameters[ 0 ].address;
+          for( size_type i = 1 ; i < COUNT ; ++ i )
+            result = Definition :: parameters[ i ].address < result ? Definition :: parameters[ i ].address : result;
+          return result;
+        }
+
+        constexpr static Address last( void ){
+          Address result = Definition :: parameters[ 0 ].address;
+          for( size_type i = 1 ; i < COUNT ; ++ i )
+            result = Definition :: parameters[ i ].address > result ? Definition :: parameters[ i ].address : result;
+          return result;
+        }
+
+        constexpr static bool unique( void ){
+          for( size_type i = 0 ; i < COUNT ; ++ i )
+            for( size_type k = i + 1 ; k < COUNT ; ++ k )
+              if( Definition :: parameters[ i ].address == Definition :: parameters[ k ].address )
+                return false;
+          return true;
+        }
+
+        constexpr static bool ordered( void ){
+          for( size_type i = 0 ; i < COUNT ; ++ i )
+            if( ! (Definition :: parameters[ i ].minimum <= Definition :: parameters[ i ].maximum) )
+              return false;
+          return true;
+        }
+
+        constexpr static bool handled( void ){
+          for( size_type i = 0 ; i < COUNT ; ++ i )
+            if( Definition :: parameters[ i ].handler == nullptr )
+              return false;
+          return true;
+        }
+
+      public:
+
+        constexpr static Address FIRST = first();            ///< lowest Address of schema
+        constexpr static Address LAST  = last();             ///< highest Address of schema
+        constexpr static Address SPAN  = LAST - FIRST < MAX_SPAN ? LAST - FIRST + 1 : 1; ///< number of entries of dense table
+
+        static_assert( COUNT != 0,              "schema has no parameter" );
+        static_assert( unique(),                "schema has duplicate Address" );
+        static_assert( LAST - FIRST < MAX_SPAN, "schema Address is out of range of dense table, raise MAX_SPAN or pack Addresses" );
+        static_assert( ordered(),               "schema parameter has minimum over maximum" );
+        static_assert( handled(),               "schema parameter has no handler" );
+
+      private:
+
+        /**
+         * @brief encode Address frame
+         */
+        constexpr static Frame encode( const Address address, const Payload payload ){
+
+          const value_type kind = payload == Payload :: QUANTIZED_14 ? Serialized :: KIND_QUANTIZED_14
+                                : payload == Payload :: QUANTIZED_21 ? Serialized :: KIND_QUANTIZED_21
+                                :                                      Serialized :: KIND_ADDRESS;
+          Frame frame = {};
+          for( size_type i = 0 ; i < Serialized :: SIZE - 1 ; ++ i )
+            frame.octets[ i ] = static_cast< value_type >( header_bit | ((address >> (7 * i)) & 0x7F) );
+          frame.octets[ Serialized :: SIZE - 1 ] = static_cast< value_type >( header_bit | kind | ((address >> 28) & 0x0F) );
+          return frame;
+        }
+
+        /**
+         * @brief build dense table
+         */
+        constexpr static Table< SPAN > build( void ){
+
+          Table< SPAN > table = {};
+
+          for( size_type i = 0 ; i < COUNT ; ++ i ){
+
+            const Parameter& parameter = Definition :: parameters[ i ];
+            const Data       maximum   = parameter.payload == Payload :: QUANTIZED_14 ? static_cast< Data >( Serialized_Quantized< 14 > :: MAX )
+                                       : parameter.payload == Payload :: QUANTIZED_21 ? static_cast< Data >( Serialized_Quantized< 21 > :: MAX )
+                                       :                                                static_cast< Data >( 1 );
+            Slot& slot = table.slots[ parameter.address - FIRST ];
+
+            slot.handler  = parameter.handler;
+            slot.minimum  = parameter.minimum;
+            slot.maximum  = parameter.maximum;
+            slot.payload  = parameter.payload;
+            slot.quantize = Quantize{ parameter.minimum, (parameter.maximum - parameter.minimum) / maximum };
+            slot.frame    = encode( parameter.address, parameter.payload );
+          }
+
+          return table;
+        }
+
+        constexpr static Table< SPAN > TABLE = build(); ///< dense table
+
+      public:
+
+        /**
+         * @brief number of parameters
+         */
+        constexpr static size_type size( void ){ return COUNT; }
+
+        /**
+         * @brief check an Address is in schema
+         */
+        constexpr static bool contains( const Address& address ){
+          return address - FIRST < SPAN && TABLE.slots[ address - FIRST ].handler != nullptr;
+        }
+
+
+        /**
+         * @brief call handler of a parameter
+         *
+         * @param[in] address   Address of parameter
+         * @param[in] data      Data, clamped to the range of parameter
+         * @return              false if Address is not in schema
+         */
+        static bool dispatch( const Address& address, const Data& data ){
+
+          const Address index = address - FIRST;   // Addresses under FIRST wrap over SPAN
+          if( index >= SPAN )
+            return false;
+
+          const Slot& slot = TABLE.slots[ index ];
+          if( slot.handler == nullptr )
+            return false;
+
+          slot.handler( ! (data >= slot.minimum) ? slot.minimum
+                      :    data >  slot.maximum  ? slot.maximum
+                      :                            data );
+          return true;
+        }
+
+        /**
+         * @brief call handler of a decoded message
+         */
+        static bool dispatch( const Message& message ){ return dispatch( message.address, message.data ); }
+
+
+        /**
+         * @brief kind of frame following Address frame of a parameter
+         *
+         * @param[in]   address   Address of parameter
+         * @param[out]  payload   kind of frame, written only when this function returns true
+         * @param[out]  quantize  mapping of quantized value, written only when this function returns true
+         * @return                false if Address is not in schema
+         */
+        static bool payload( const Address& address, Payload& payload, Quantize& quantize ){
+          if( ! contains( address ) )
+            return false;
+          payload  = TABLE.slots[ address - FIRST ].payload;
+          quantize = TABLE.slots[ address - FIRST ].quantize;
+          return true;
+        }
+
+        /**
+         * @brief encoded Address frame of a parameter
+         *
+         * @param[in] address   Address of parameter
+         * @return              encoded frame, nullptr if Address is not in schema
+         */
+        static const Frame* frame( const Address& address ){
+          return contains( address ) ? &TABLE.slots[ address - FIRST ].frame : nullptr;
+        }
+
+        /**
+         * @brief encoded Address frame of a parameter, checked at compile time
+         *
+         * @tparam    ADDRESS   Address of parameter
+         */
+        template < Address ADDRESS >
+        static const Frame& frame( void ){
+          static_assert( contains( ADDRESS ), "Address is not in schema" );
+          return TABLE.slots[ ADDRESS - FIRST ].frame;
+        }
+
+    };
+
+    template < typename Definition, Address MAX_SPAN >
+    constexpr typename Dispatcher< Definition, MAX_SPAN > :: template Table< Dispatcher< Definition, MAX_SPAN > :: SPAN > Dispatcher< Definition, MAX_SPAN > :: TABLE;
+
+  }
+
+}
+
+#endif
+
+#endif /* SimpleControlSimpleControl_Schema_h */
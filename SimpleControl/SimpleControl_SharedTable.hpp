@@ -0,0 +1,355 @@
+/**
+ *  @file           SimpleControl_SharedTable.hpp
+ *  @brief          This class provides parameter table in shared memory, one writer and many reader processes, for POSIX.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * A table has a slot for each Address in `[ first, first + count )`, created by `shm_open` and mapped by `mmap`.
+ *
+ * | part   | size                | contents                                                  |
+ * | ------ | ------------------- | --------------------------------------------------------- |
+ * | header | 64 octets           | magic, layout version, first Address, count, change counter |
+ * | slots  | 16 octets per slot  | sequence, Data, timestamp                                 |
+ *
+ * Each slot is guarded by a seqlock. Writer makes sequence odd, writes Data and timestamp, and makes it even again.
+ * Reader reads sequence, Data, timestamp and sequence again, and retries while it is odd or changed,
+ * so a reader never blocks writer nor other readers, and never calls system calls after open().
+ * A reader gives up after READ_RETRIES tries, ex. while writer is stopped in a write.
+ *
+ * create() never resizes an existing table, mapped readers would fault on truncated pages.
+ * A table of same Addresses is opened again as is, ex. by restarted writer, a table of other size or Addresses is refused until remove().
+ * Slots left odd by a writer died in a write are made even again, their Data may be torn but readers are never stuck.
+ *
+ * Name of table follows `shm_open`, starts with `/`. macOS limits names to 31 characters.
+ */
+
+#ifndef SimpleControlSimpleControl_SharedTable_h
+#define SimpleControlSimpleControl_SharedTable_h
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+
+#include "SimpleControl_Types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides seqlock parameter table in shared memory
+   *
+   * @note write() is called from one thread of one process, read() is called from any thread of any process
+   */
+  class SharedTable {
+
+    static_assert( ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "SharedTable requires lock free atomics, they are shared between processes" );
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+      constexpr static std :: uint32_t MAGIC  = 0x54435053; ///< "SPCT", marker of table
+      constexpr static std :: uint32_t LAYOUT = 1;          ///< layout version
+
+      constexpr static size_type READ_RETRIES = 1 << 16;    ///< maximum tries of read() while slot is written
+
+    private:
+
+      /**
+       * @brief header of table
+       */
+      struct alignas( 64 ) Header {
+        std :: atomic< std :: uint32_t > magic;   ///< MAGIC when table is initialized, released after other fields
+        std :: uint32_t                  layout;  ///< LAYOUT of writer
+        Address                          first;   ///< Address of slot 0
+        std :: uint32_t                  count;   ///< number of slots
+        std :: atomic< std :: uint64_t > changes; ///< number of writes
+      };
+
+      /**
+       * @brief slot of a parameter
+       */
+      struct Slot {
+        std :: atomic< std :: uint32_t > sequence; ///< odd while writing
+        std :: atomic< std :: uint32_t > data;     ///< raw bits of Data
+        std :: atomic< std :: uint64_t > time;     ///< timestamp of write
+      };
+
+      Header*   _header;   ///< mapped header, nullptr if not opened
+      Slot*     _slots;    ///< mapped slots
+      size_type _size;     ///< mapped octets
+      bool      _writable; ///< true if opened by create()
+
+    public:
+
+      /**
+       * @brief default constructor, not opened
+       */
+      SharedTable( void ) :
+          _header( nullptr )
+        , _slots( nullptr )
+        , _size( 0 )
+        , _writable( false )
+      {}
+
+      /**
+       * @brief destructor, unmap table, shared memory is kept until remove()
+       */
+      ~SharedTable( void ){ close(); }
+
+      SharedTable( const SharedTable& ) = delete;
+      SharedTable& operator= ( const SharedTable& ) = delete;
+
+
+      bool      is_open( void ) const { return _header != nullptr; }                           ///< true if table is mapped
+      Address   first  ( void ) const { return _header != nullptr ? _header -> first : 0; } ///< Address of slot 0, 0 if not opened
+      size_type size   ( void ) const { return _header != nullptr ? _header -> count : 0; } ///< number of slots, 0 if not opened
+
+      /**
+       * @brief number of writes, readers poll it to find changes, 0 if not opened
+       */
+      std :: uint64_t changes( void ) const { return _header != nullptr ? _header -> changes.load( std :: memory_order_acquire ) : 0; }
+
+
+      /**
+       * @brief create table as writer, all slots are 0, or open existing table of same Addresses as writer, slots are kept
+       *
+       * @param[in] name    name of shared memory
+       * @param[in] first   Address of slot 0
+       * @param[in] count   number of slots
+       * @return            false if shared memory is not available, or existing table has other size or Addresses
+       */
+      bool create( const char* name, const Address& first, const size_type count ){
+
+        close();
+
+        const int fd = shm_open( name, O_CREAT | O_RDWR, 0644 );
+        if( fd < 0 )
+          return false;
+
+        const size_type size = sizeof( Header ) + sizeof( Slot ) * count;
+
+        // existing table is never resized, readers may map it
+        struct stat status;
+        const bool ready = fstat( fd, &status ) == 0
+                        && (status.st_size == 0 ? ftruncate( fd, static_cast< off_t >( size ) ) == 0 : static_cast< size_type >( status.st_size ) == size);
+        if( ! ready || ! map( fd, size, true ) ){
+          :: close( fd );
+          return false;
+        }
+        :: close( fd );
+
+        if( _header -> magic.load( std :: memory_order_acquire ) == MAGIC ){
+
+          if( _header -> layout != LAYOUT || _header -> first != first || _header -> count != count ){
+            close();
+            return false;
+          }
+
+          // previous writer died in a write, an odd sequence would invert seqlock of the slot for good
+          for( size_type i = 0 ; i < count ; ++ i ){
+            const std :: uint32_t sequence = _slots[ i ].sequence.load( std :: memory_order_relaxed );
+            if( (sequence & 1) != 0 )
+              _slots[ i ].sequence.store( sequence + 1, std :: memory_order_release );
+          }
+          return true;
+        }
+
+        // new or unfinished table, readers see MAGIC after all slots are initialized
+        for( size_type i = 0 ; i < count ; ++ i ){
+          new ( &_slots[ i ].sequence ) std :: atomic< std :: uint32_t >( 0 );
+          new ( &_slots[ i ].data )     std :: atomic< std :: uint32_t >( 0 );
+          new ( &_slots[ i ].time )     std :: atomic< std :: uint64_t >( 0 );
+        }
+        new ( &_header -> changes ) std :: atomic< std :: uint64_t >( 0 );
+        _header -> layout = LAYOUT;
+        _header -> first  = first;
+        _header -> count  = static_cast< std :: uint32_t >( count );
+
+        _header -> magic.store( MAGIC, std :: memory_order_release );
+        return true;
+      }
+
+      /**
+       * @brief open existing table as reader
+       *
+       * @param[in] name    name of shared memory
+       * @return            false if table doesn't exist or is not initialized yet
+       */
+      bool open( const char* name ){
+
+        close();
+
+        const int fd = shm_open( name, O_RDONLY, 0 );
+        if( fd < 0 )
+          return false;
+
+        struct stat status;
+        if( fstat( fd, &status ) != 0 || static_cast< size_type >( status.st_size ) < sizeof( Header ) || ! map( fd, static_cast< size_type >( status.st_size ), false ) ){
+          :: close( fd );
+          return false;
+        }
+        :: close( fd );
+
+        const bool valid = _header -> magic.load( std :: memory_order_acquire ) == MAGIC
+                        && _header -> layout == LAYOUT
+                        && sizeof( Header ) + sizeof( Slot ) * _header -> count <= _size;
+
+        if( ! valid )
+          close();
+        return valid;
+      }
+
+      /**
+       * @brief unmap table
+       */
+      void close( void ){
+        if( _header != nullptr )
+          munmap( _header, _size );
+        _header   = nullptr;
+        _slots    = nullptr;
+        _size     = 0;
+        _writable = false;
+      }
+
+      /**
+       * @brief remove shared memory, mapped tables are still available until closed
+       */
+      static bool remove( const char* name ){ return shm_unlink( name ) == 0; }
+
+
+      /**
+       * @brief publish Data of a parameter
+       *
+       * @param[in] address   Address of parameter
+       * @param[in] data      new Data
+       * @param[in] time      timestamp, unit is chosen by writer
+       * @return              false if Address is out of table or table is not opened as writer
+       */
+      bool write( const Address& address, const Data& data, const std :: uint64_t time = 0 ){
+
+        if( ! _writable )
+          return false;
+
+        const Address index = address - _header -> first;
+        if( index >= _header -> count )
+          return false;
+
+        std :: uint32_t bits;
+        std :: memcpy( &bits, &data, sizeof( bits ) );
+
+        Slot&                 slot     = _slots[ index ];
+        const std :: uint32_t sequence = slot.sequence.load( std :: memory_order_relaxed );
+
+        slot.sequence.store( sequence + 1, std :: memory_order_relaxed );
+        std :: atomic_thread_fence( std :: memory_order_release );
+        slot.data.store( bits, std :: memory_order_relaxed );
+        slot.time.store( time, std :: memory_order_relaxed );
+        slot.sequence.store( sequence + 2, std :: memory_order_release );
+
+        // single writer, so no read-modify-write is required
+        _header -> changes.store( _header -> changes.load( std :: memory_order_relaxed ) + 1, std :: memory_order_release );
+        return true;
+      }
+
+      /**
+       * @brief publish a batch of decoded messages
+       *
+       * @return  number of published messages
+       */
+      size_type write( const Message* messages, const size_type count, const std :: uint64_t time = 0 ){
+        size_type result = 0;
+        for( size_type i = 0 ; i < count ; ++ i )
+          result += write( messages[ i ].address, messages[ i ].data, time ) ? 1 : 0;
+        return result;
+      }
+
+
+      /**
+       * @brief read latest Data of a parameter
+       *
+       * @param[in]   address   Address of parameter
+       * @param[out]  data      latest Data, written only when this function returns true
+       * @param[out]  time      timestamp of latest Data, nullptr to ignore
+       * @return                false if Address is out of table, table is not opened, or slot was written in all READ_RETRIES tries
+       */
+      bool read( const Address& address, Data& data, std :: uint64_t* time = nullptr ) const {
+
+        if( _header == nullptr )
+          return false;
+
+        const Address index = address - _header -> first;
+        if( index >= _header -> count )
+          return false;
+
+        const Slot&     slot = _slots[ index ];
+        std :: uint32_t bits;
+        std :: uint64_t stamp;
+
+        for( size_type retry = 0 ; ; ++ retry ){
+          if( retry == READ_RETRIES )
+            return false;
+          const std :: uint32_t before = slot.sequence.load( std :: memory_order_acquire );
+          bits  = slot.data.load( std :: memory_order_relaxed );
+          stamp = slot.time.load( std :: memory_order_relaxed );
+          std :: atomic_thread_fence( std :: memory_order_acquire );
+          if( (before & 1) == 0 && slot.sequence.load( std :: memory_order_relaxed ) == before )
+            break;
+        }
+
+        std :: memcpy( &data, &bits, sizeof( data ) );
+        if( time != nullptr )
+          *time = stamp;
+        return true;
+      }
+
+      /**
+       * @brief read latest Data of consecutive parameters, each slot is consistent
+       *
+       * @param[in]   address   Address of first parameter
+       * @param[out]  output    latest Data, requires count elements
+       * @param[in]   count     number of parameters
+       * @return                number of read parameters, less than count at the end of table or at a slot read() gave up
+       */
+      size_type read( const Address& address, Data* output, const size_type count ) const {
+        size_type i = 0;
+        for( ; i < count && read( static_cast< Address >( address + i ), output[ i ] ) ; ++ i ) ;
+        return i;
+      }
+
+
+    private:
+
+      /**
+       * @brief map shared memory
+       */
+      bool map( const int fd, const size_type size, const bool writable ){
+
+        void* memory = mmap( nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0 );
+        if( memory == MAP_FAILED )
+          return false;
+
+        _header   = static_cast< Header* >( memory );
+        _slots    = reinterpret_cast< Slot* >( static_cast< char* >( memory ) + sizeof( Header ) );
+        _size     = size;
+        _writable = writable;
+        return true;
+      }
+
+  };
+
+}
+
+#endif
+
+#endif /* SimpleControlSimpleControl_SharedTable_h */
@@ -0,0 +1,125 @@
+/**
+ *  @file           SimpleControl_SpscQueue.hpp
+ *  @brief          This class provides bounded lock free single producer single consumer queue, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Ring buffer with producer / consumer indices on separate cache lines.
+ * Each side caches the other index, and reloads it only when the ring looks full / empty.
+ */
+
+#ifndef SimpleControlSimpleControl_SpscQueue_h
+#define SimpleControlSimpleControl_SpscQueue_h
+
+#include <atomic>
+#include <cstddef>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides bounded lock free single producer single consumer queue
+   *
+   * @note push() is called from one thread, pop() is called from one other thread
+   *
+   * @tparam    T           element type, copy assignable
+   * @tparam    CAPACITY    number of elements, power of 2
+   */
+  template < typename T, std :: size_t CAPACITY >
+  class SpscQueue {
+
+    static_assert( CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue CAPACITY must be power of 2" );
+
+    public:
+      using value_type = T;             ///< element type
+      using size_type  = std :: size_t; ///< size type
+
+    private:
+      constexpr static size_type CACHE_LINE = 64;
+
+      alignas( CACHE_LINE ) std :: atomic< size_type > _head; ///< next index to pop, written by consumer
+      size_type                                        _tail_cache; ///< last seen _tail, used by consumer
+
+      alignas( CACHE_LINE ) std :: atomic< size_type > _tail; ///< next index to push, written by producer
+      size_type                                        _head_cache; ///< last seen _head, used by producer
+
+      alignas( CACHE_LINE ) T _items[ CAPACITY ]; ///< ring buffer
+
+    public:
+
+      /**
+       * @brief default constructor, queue is empty
+       */
+      SpscQueue( void ) : _head( 0 ), _tail_cache( 0 ), _tail( 0 ), _head_cache( 0 ), _items() {}
+
+      SpscQueue( const SpscQueue& ) = delete;
+      SpscQueue& operator= ( const SpscQueue& ) = delete;
+
+
+      /**
+       * @brief push an element, producer side
+       *
+       * @param[in] item    element to push
+       * @return            false if queue is full
+       */
+      bool push( const T& item ){
+
+        const size_type tail = _tail.load( std :: memory_order_relaxed );
+
+        if( tail - _head_cache == CAPACITY ){
+          _head_cache = _head.load( std :: memory_order_acquire );
+          if( tail - _head_cache == CAPACITY )
+            return false;
+        }
+
+        _items[ tail & (CAPACITY - 1) ] = item;
+        _tail.store( tail + 1, std :: memory_order_release );
+        return true;
+      }
+
+      /**
+       * @brief pop an element, consumer side
+       *
+       * @param[out] item   popped element
+       * @return            false if queue is empty
+       */
+      bool pop( T& item ){
+
+        const size_type head = _head.load( std :: memory_order_relaxed );
+
+        if( head == _tail_cache ){
+          _tail_cache = _tail.load( std :: memory_order_acquire );
+          if( head == _tail_cache )
+            return false;
+        }
+
+        item = _items[ head & (CAPACITY - 1) ];
+        _head.store( head + 1, std :: memory_order_release );
+        return true;
+      }
+
+
+      /**
+       * @brief number of elements, approximate while other side is running
+       */
+      size_type size( void ) const {
+        return _tail.load( std :: memory_order_acquire ) - _head.load( std :: memory_order_acquire );
+      }
+
+      /**
+       * @brief true if queue looks empty
+       */
+      bool empty( void ) const { return size() == 0; }
+
+      /**
+       * @brief capacity of queue
+       */
+      constexpr static size_type capacity( void ){ return CAPACITY; }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_SpscQueue_h */
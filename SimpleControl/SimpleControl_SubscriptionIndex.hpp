@@ -0,0 +1,319 @@
+/**
+ *  @file           SimpleControl_SubscriptionIndex.hpp
+ *  @brief          This class provides subscription index, to find subscribers of an Address, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Subscriptions ( Address range or Address prefix ) are compiled into a sorted table of elementary intervals.
+ * All Addresses in an interval have same subscribers, so each interval refers to a precomputed subscriber set.
+ * Same sets are shared by intervals.
+ *
+ * build() compiles subscriptions, changes of subscriptions are not seen by match() until next build().
+ * match() is a branchless binary search over intervals ( see Intervals ), it doesn't depend on number of subscribers.
+ * Batch match() runs 8 searches at once, to hide memory latency of the table.
+ */
+
+#ifndef SimpleControlSimpleControl_SubscriptionIndex_h
+#define SimpleControlSimpleControl_SubscriptionIndex_h
+
+#include "SimpleControl_Types.hpp"
+#include "SimpleControl_Intervals.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides index of subscribers by Address
+   *
+   * @note match() is const and can be called from multiple threads, while subscriptions are not changed or built
+   */
+  class SubscriptionIndex {
+
+    public:
+      using Subscriber = std :: uint32_t; ///< subscriber id
+      using size_type  = std :: size_t;   ///< size type
+
+      /**
+       * @brief view of a subscriber set, sorted by id, valid until next build()
+       */
+      struct Set {
+        const Subscriber* data; ///< first subscriber
+        size_type         size; ///< number of subscribers
+
+        const Subscriber* begin( void ) const { return data; }        ///< first subscriber
+        const Subscriber* end  ( void ) const { return data + size; } ///< end of subscribers
+        bool              empty( void ) const { return size == 0; }   ///< true if no subscriber
+      };
+
+    private:
+      constexpr static size_type LANES = 8; ///< searches at once in batch match
+
+      /**
+       * @brief a subscription
+       */
+      struct Subscription {
+        Address    low;        ///< first Address
+        Address    high;       ///< last Address
+        Subscriber subscriber; ///< subscriber id
+      };
+
+      std :: vector< Subscription > _subscriptions; ///< all subscriptions
+      bool                          _dirty;         ///< true if subscriptions are changed after build
+
+      Intervals                        _intervals; ///< elementary intervals of subscriptions
+      std :: vector< std :: uint32_t > _sets;      ///< set index of each interval
+      std :: vector< size_type >       _offsets;   ///< start of each set in _members, and end at last
+      std :: vector< Subscriber >      _members;   ///< subscribers of all sets
+
+    public:
+
+      /**
+       * @brief default constructor, no subscriptions
+       */
+      SubscriptionIndex( void ) :
+          _subscriptions()
+        , _dirty( false )
+        , _intervals()
+        , _sets( 1, 0 )
+        , _offsets( 2, 0 )
+        , _members()
+      {}
+
+
+      /**
+       * @brief subscribe Addresses in `[ low, high ]`
+       *
+       * @param[in] subscriber  subscriber id
+       * @param[in] low         first Address
+       * @param[in] high        last Address
+       * @return                false if low is over high
+       */
+      bool subscribe( const Subscriber subscriber, const Address& low, const Address& high ){
+        if( low > high )
+          return false;
+        _subscriptions.push_back( Subscription{ low, high, subscriber } );
+        _dirty = true;
+        return true;
+      }
+
+      /**
+       * @brief subscribe Addresses which have same upper bits as prefix
+       *
+       * @param[in] subscriber  subscriber id
+       * @param[in] prefix      Address pattern
+       * @param[in] bits        number of upper bits to compare, 0 for all Addresses
+       * @return                false if bits is over bits of Address
+       */
+      bool subscribe_prefix( const Subscriber subscriber, const Address& prefix, const unsigned int bits ){
+
+        constexpr unsigned int ADDRESS_BITS = sizeof( Address ) * 8;
+
+        if( bits > ADDRESS_BITS )
+          return false;
+
+        const Address rest = bits == 0 ? static_cast< Address >( ~static_cast< Address >( 0 ) )
+                                       : static_cast< Address >( (static_cast< Address >( 1 ) << (ADDRESS_BITS - bits)) - 1 );
+        const Address low  = prefix & static_cast< Address >( ~rest );
+
+        return subscribe( subscriber, low, low | rest );
+      }
+
+      /**
+       * @brief remove all subscriptions of a subscriber
+       *
+       * @param[in] subscriber  subscriber id
+       * @return                number of removed subscriptions
+       */
+      size_type unsubscribe( const Subscriber subscriber ){
+
+        const size_type before = _subscriptions.size();
+        _subscriptions.erase(
+            std :: remove_if( _subscriptions.begin(), _subscriptions.end()
+              , [ subscriber ]( const Subscription& subscription ){ return subscription.subscriber == subscriber; } )
+          , _subscriptions.end() );
+
+        if( _subscriptions.size() != before )
+          _dirty = true;
+        return before - _subscriptions.size();
+      }
+
+      size_type size ( void ) const { return _subscriptions.size(); } ///< number of subscriptions
+      bool      dirty( void ) const { return _dirty; }                ///< true if subscriptions are changed after build()
+
+
+      /**
+       * @brief subscribers of an Address
+       *
+       * @param[in] address   Address of a message
+       * @return              subscriber set of the last build()
+       */
+      Set match( const Address& address ) const {
+        return set( _sets[ _intervals.find( address ) ] );
+      }
+
+      /**
+       * @brief subscribers of a batch of Addresses
+       *
+       * @param[in]   addresses   Addresses of messages
+       * @param[in]   count       number of Addresses
+       * @param[out]  output      subscriber set of the last build() for each Address, requires count sets
+       */
+      void match( const Address* addresses, const size_type count, Set* output ) const {
+
+        size_type i = 0;
+
+        for( ; i + LANES <= count ; i += LANES ){
+          size_type index[ LANES ];
+          _intervals.find< LANES >( addresses + i, index );
+          for( size_type k = 0 ; k < LANES ; ++ k )
+            output[ i + k ] = set( _sets[ index[ k ] ] );
+        }
+
+        for( ; i < count ; ++ i )
+          output[ i ] = match( addresses[ i ] );
+      }
+
+
+      /**
+       * @brief compile subscriptions, call it after subscriptions are changed and before match()
+       *
+       * intervals are swept once, keeping active subscriber counts and a hash of the active set,
+       * a set is copied only when no same set is known. the cost is O( subscriptions log subscriptions )
+       * plus the size of distinct sets, which is O( intervals x subscribers ) for heavily overlapping subscriptions.
+       */
+      void build( void ){
+
+        _intervals.clear();
+        for( const Subscription& subscription : _subscriptions )
+          _intervals.add( subscription.low, subscription.high );
+        _intervals.sort();
+
+        // compact ids of subscribers, in order of id
+        std :: vector< Subscriber > ids;
+        ids.reserve( _subscriptions.size() );
+        for( const Subscription& subscription : _subscriptions )
+          ids.push_back( subscription.subscriber );
+        std :: sort( ids.begin(), ids.end() );
+        ids.erase( std :: unique( ids.begin(), ids.end() ), ids.end() );
+
+        // events of subscriptions at each interval, compact id and +1 for start or -1 for end
+        std :: vector< size_type >                                   heads( _intervals.size() + 3, 0 );
+        std :: vector< std :: pair< std :: uint32_t, std :: int32_t > > events( _subscriptions.size() * 2 );
+        for( const Subscription& subscription : _subscriptions ){
+          ++ heads[ _intervals.first( subscription.low  ) + 2 ];
+          ++ heads[ _intervals.end  ( subscription.high ) + 2 ];
+        }
+        for( size_type interval = 2 ; interval < heads.size() ; ++ interval )
+          heads[ interval ] += heads[ interval - 1 ];
+        for( const Subscription& subscription : _subscriptions ){
+          const std :: uint32_t id = static_cast< std :: uint32_t >( std :: lower_bound( ids.begin(), ids.end(), subscription.subscriber ) - ids.begin() );
+          events[ heads[ _intervals.first( subscription.low  ) + 1 ] ++ ] = std :: make_pair( id,  1 );
+          events[ heads[ _intervals.end  ( subscription.high ) + 1 ] ++ ] = std :: make_pair( id, -1 );
+        }
+
+        // sweep intervals with active subscription counts, and share same sets by hash
+        std :: vector< size_type >                                counts( ids.size(), 0 );
+        std :: vector< std :: uint32_t >                          active;
+        std :: vector< size_type >                                position( ids.size(), 0 );
+        std :: unordered_map< std :: uint64_t, std :: uint32_t > known;
+        std :: uint64_t                                           hash = 0;
+
+        _sets   .assign( _intervals.size(), 0 );
+        _offsets.assign( 1, 0 );
+        _members.clear();
+
+        for( size_type interval = 0 ; interval < _intervals.size() ; ++ interval ){
+
+          for( size_type event = heads[ interval ] ; event < heads[ interval + 1 ] ; ++ event ){
+
+            const std :: uint32_t id = events[ event ].first;
+            const bool            on = events[ event ].second > 0;
+
+            if( on ? counts[ id ] ++ != 0 : -- counts[ id ] != 0 )
+              continue;
+
+            hash ^= mix( id );
+            if( on ){
+              position[ id ] = active.size();
+              active.push_back( id );
+            }
+            else {
+              active[ position[ id ] ] = active.back();
+              position[ active.back() ] = position[ id ];
+              active.pop_back();
+            }
+          }
+
+          const std :: unordered_map< std :: uint64_t, std :: uint32_t > :: const_iterator found = known.find( hash );
+          if( found != known.end() && same( found -> second, active.size(), counts, ids ) ){
+            _sets[ interval ] = found -> second;
+            continue;
+          }
+
+          const std :: uint32_t index = static_cast< std :: uint32_t >( _offsets.size() - 1 );
+          const size_type       begin = _members.size();
+          for( const std :: uint32_t id : active )
+            _members.push_back( ids[ id ] );
+          std :: sort( _members.begin() + begin, _members.end() );
+          _offsets.push_back( _members.size() );
+
+          known.emplace( hash, index );
+          _sets[ interval ] = index;
+        }
+
+        _dirty = false;
+      }
+
+
+    private:
+
+      /**
+       * @brief hash of a compact subscriber id, hash of a set is xor of its members
+       */
+      static std :: uint64_t mix( const std :: uint32_t id ){
+        std :: uint64_t x = id + 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+      }
+
+      /**
+       * @brief true if a known set has same subscribers as the active set
+       *
+       * @param[in] index   index of known set
+       * @param[in] size    number of active subscribers
+       * @param[in] counts  active subscription count of each compact id
+       * @param[in] ids     subscriber of each compact id
+       */
+      bool same( const std :: uint32_t index, const size_type size, const std :: vector< size_type >& counts, const std :: vector< Subscriber >& ids ) const {
+
+        if( _offsets[ index + 1 ] - _offsets[ index ] != size )
+          return false;
+
+        for( size_type member = _offsets[ index ] ; member < _offsets[ index + 1 ] ; ++ member )
+          if( counts[ static_cast< size_type >( std :: lower_bound( ids.begin(), ids.end(), _members[ member ] ) - ids.begin() ) ] == 0 )
+            return false;
+        return true;
+      }
+
+      /**
+       * @brief view of a set
+       */
+      Set set( const std :: uint32_t index ) const {
+        return Set{ _members.data() + _offsets[ index ], _offsets[ index + 1 ] - _offsets[ index ] };
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_SubscriptionIndex_h */
@@ -0,0 +1,571 @@
+/**
+ *  @file           SimpleControl_Trace.hpp
+ *  @brief          This class provides opt-in tracing of message flow, exported as Chrome trace JSON or Perfetto protobuf, for general C++.
+ *  @author         leico
+ *  @date           2026.10.19
+ *  $Version:       0$
+ *  $Revision:      1$
+ *  @par
+ *
+ * Each thread records events into its own ring buffer, the oldest events are overwritten.
+ * Recording is a clock read, a release fence and 4 relaxed stores into the ring of calling thread, no lock and no allocation
+ * after the first event of the thread, so tracing can stay armed in production.
+ * Nothing is recorded until arm( true ).
+ *
+ * A ring of an exited thread is dropped by the first export after its last event,
+ * and only the latest EXITED rings of exited threads are kept until then, so thread churn doesn't grow memory.
+ *
+ * | export             | format                                                        | viewer                       |
+ * | ------------------ | ------------------------------------------------------------- | ---------------------------- |
+ * | write_chrome()     | Chrome trace event JSON, complete events ( `"ph":"X"` )        | chrome://tracing, Perfetto UI |
+ * | write_perfetto()   | Perfetto `Trace` protobuf, a track per thread and slice events | Perfetto UI, trace_processor |
+ *
+ * Both exports take a time window, ex. some milliseconds around `now()` when a latency spike is found.
+ *
+ * @code
+ * {
+ *   SimpleControl :: Trace :: Scope scope( SimpleControl :: Trace :: PARSE, 0, length );
+ *   parser.parse( ... );
+ * }
+ * @endcode
+ */
+
+#ifndef SimpleControlSimpleControl_Trace_h
+#define SimpleControlSimpleControl_Trace_h
+
+#include "SimpleControl_Types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace SimpleControl {
+
+  /**
+   * @brief this class provides per thread trace rings and exports
+   *
+   * @note record() is called from any thread, exports are called from any thread while recording
+   */
+  class Trace {
+
+    public:
+      using size_type = std :: size_t; ///< size type
+
+      /**
+       * @brief stage of message flow
+       */
+      enum Stage : std :: uint8_t {
+          ENCODE    ///< encode messages into octets
+        , ENQUEUE   ///< pass messages or octets to other thread
+        , WRITE     ///< write octets to transport
+        , READ      ///< read octets from transport
+        , PARSE     ///< find frames in octets
+        , DECODE    ///< decode frames into messages
+        , DISPATCH  ///< call handlers of messages
+        , STAGES    ///< number of stages
+      };
+
+      /**
+       * @brief a recorded event
+       */
+      struct Event {
+        std :: uint64_t start;    ///< start time in nanoseconds of now()
+        std :: uint32_t duration; ///< duration in nanoseconds, 0 for instant event
+        std :: uint32_t count;    ///< number of messages or octets
+        Address         address;  ///< Address related to event
+        Stage           stage;    ///< stage
+        std :: uint32_t thread;   ///< id of recording thread
+      };
+
+      constexpr static size_type CAPACITY = 1 << 14; ///< events per thread
+      constexpr static size_type EXITED   = 16;      ///< rings of exited threads kept until exported
+
+    private:
+
+      /**
+       * @brief ring of a thread, each event is 3 words written by relaxed stores
+       */
+      struct Ring {
+        std :: atomic< std :: uint64_t > words[ CAPACITY * 3 ]; ///< start, duration | count, address | stage
+        std :: atomic< std :: uint64_t > head;                  ///< number of recorded events
+        std :: atomic< bool >            exited;                ///< true after thread exit
+        std :: uint32_t                  thread;                ///< id of thread
+        std :: string                    name;                  ///< name of thread
+
+        explicit Ring( const std :: uint32_t id ) : head( 0 ), exited( false ), thread( id ), name( "thread " + std :: to_string( id ) ) {
+          for( std :: atomic< std :: uint64_t >& word : words )
+            word.store( 0, std :: memory_order_relaxed );
+        }
+      };
+
+      /**
+       * @brief rings of all threads, rings of exited threads are kept until exported
+       */
+      struct Registry {
+        std :: mutex                               mutex;  ///< guard of rings
+        std :: vector< std :: shared_ptr< Ring > > rings;  ///< rings, in creation order
+        std :: uint32_t                            thread; ///< id of last thread
+      };
+
+      /**
+       * @brief ring of calling thread, marks ring as exited at thread exit
+       */
+      struct Owner {
+        std :: shared_ptr< Ring > ring; ///< ring of thread, empty until first event
+
+        ~Owner( void ){
+          if( ring )
+            ring -> exited.store( true, std :: memory_order_release );
+        }
+      };
+
+      static Registry& registry( void ){
+        static Registry instance{ {}, {}, 0 };
+        return instance;
+      }
+
+      static std :: atomic< bool >& armed_flag( void ){
+        static std :: atomic< bool > instance( false );
+        return instance;
+      }
+
+      static Ring& local( void ){
+        thread_local Owner owner;
+        if( ! owner.ring ){
+          Registry&                      instance = registry();
+          std :: lock_guard< std :: mutex > lock( instance.mutex );
+
+          // oldest rings of exited threads are dropped over EXITED
+          std :: vector< std :: shared_ptr< Ring > >& rings = instance.rings;
+          size_type exited = static_cast< size_type >( std :: count_if( rings.begin(), rings.end()
+              , []( const std :: shared_ptr< Ring >& ring ){ return ring -> exited.load( std :: memory_order_acquire ); } ) );
+          rings.erase( std :: remove_if( rings.begin(), rings.end(), [ &exited ]( const std :: shared_ptr< Ring >& ring ){
+              if( exited < EXITED || ! ring -> exited.load( std :: memory_order_acquire ) )
+                return false;
+              -- exited;
+              return true;
+            } ), rings.end() );
+
+          owner.ring = std :: make_shared< Ring >( ++ instance.thread );
+          rings.push_back( owner.ring );
+        }
+        return *owner.ring;
+      }
+
+    public:
+
+      /**
+       * @brief scope of a stage, records a complete event at destruction when armed
+       */
+      class Scope {
+
+          std :: uint64_t _start;   ///< start time, 0 if not armed
+          Address         _address; ///< Address related to event
+          std :: uint32_t _count;   ///< number of messages or octets
+          Stage           _stage;   ///< stage
+
+        public:
+
+          /**
+           * @brief start a scope
+           *
+           * @param[in] stage     stage
+           * @param[in] address   Address related to event
+           * @param[in] count     number of messages or octets
+           */
+          Scope( const Stage stage, const Address& address = 0, const std :: uint32_t count = 0 ) :
+              _start( armed() ? now() : 0 )
+            , _address( address )
+            , _count( count )
+            , _stage( stage )
+          {}
+
+          ~Scope( void ){
+            if( _start != 0 )
+              record( _stage, _start, now(), _address, _count );
+          }
+
+          Scope( const Scope& ) = delete;
+          Scope& operator= ( const Scope& ) = delete;
+
+          void count( const std :: uint32_t count ){ _count = count; } ///< set count found in the scope
+      };
+
+
+      /**
+       * @brief arm or disarm recording
+       */
+      static void arm( const bool armed ){ armed_flag().store( armed, std :: memory_order_relaxed ); }
+
+      /**
+       * @brief true if recording is armed
+       */
+      static bool armed( void ){ return armed_flag().load( std :: memory_order_relaxed ); }
+
+      /**
+       * @brief current time in nanoseconds, time base of events
+       */
+      static std :: uint64_t now( void ){
+        return static_cast< std :: uint64_t >( std :: chrono :: duration_cast< std :: chrono :: nanoseconds >(
+              std :: chrono :: steady_clock :: now().time_since_epoch() ).count() );
+      }
+
+      /**
+       * @brief name calling thread in exports
+       */
+      static void name_thread( const std :: string& name ){
+        Ring&                          ring = local();
+        std :: lock_guard< std :: mutex > lock( registry().mutex );
+        ring.name = name;
+      }
+
+
+      /**
+       * @brief record an event when armed
+       *
+       * @param[in] stage     stage
+       * @param[in] start     start time by now()
+       * @param[in] end       end time by now(), same as start for instant event
+       * @param[in] address   Address related to event
+       * @param[in] count     number of messages or octets
+       */
+      static void record( const Stage stage, const std :: uint64_t start, const std :: uint64_t end, const Address& address = 0, const std :: uint32_t count = 0 ){
+
+        if( ! armed() )
+          return;
+
+        Ring&                 ring     = local();
+        const std :: uint64_t head     = ring.head.load( std :: memory_order_relaxed );
+        const std :: uint64_t duration = std :: min< std :: uint64_t >( end - start, 0xFFFFFFFF );
+        std :: atomic< std :: uint64_t >* word = ring.words + (head % CAPACITY) * 3;
+
+        // words of the slot are not visible before previous head, same as seqlock writer
+        std :: atomic_thread_fence( std :: memory_order_release );
+        word[ 0 ].store( start,                                                       std :: memory_order_relaxed );
+        word[ 1 ].store( duration << 32 | count,                                      std :: memory_order_relaxed );
+        word[ 2 ].store( static_cast< std :: uint64_t >( stage ) << 32 | address,    std :: memory_order_relaxed );
+        ring.head.store( head + 1, std :: memory_order_release );
+      }
+
+      /**
+       * @brief record an instant event at now()
+       */
+      static void mark( const Stage stage, const Address& address = 0, const std :: uint32_t count = 0 ){
+        if( ! armed() )
+          return;
+        const std :: uint64_t time = now();
+        record( stage, time, time, address, count );
+      }
+
+
+      /**
+       * @brief collect events of all threads in a time window
+       *
+       * @param[in]   from    first time of window
+       * @param[in]   to      last time of window
+       * @param[out]  output  events starting in window are appended, sorted by start time
+       *
+       * rings of exited threads are dropped when all their events are before `to`
+       */
+      static void collect( const std :: uint64_t from, const std :: uint64_t to, std :: vector< Event >& output ){
+
+        const size_type first = output.size();
+
+        std :: vector< std :: shared_ptr< Ring > > rings;
+        {
+          std :: lock_guard< std :: mutex > lock( registry().mutex );
+          rings = registry().rings;
+        }
+
+        std :: vector< std :: uint64_t >           indices;
+        std :: vector< std :: shared_ptr< Ring > > exported;
+
+        for( const std :: shared_ptr< Ring >& ring : rings ){
+
+          const bool            exited = ring -> exited.load( std :: memory_order_acquire );
+          bool                  later  = false;
+          const std :: uint64_t head   = ring -> head.load( std :: memory_order_acquire );
+          const std :: uint64_t begin = head > CAPACITY ? head - CAPACITY : 0;
+          const size_type       mark  = output.size();
+
+          indices.clear();
+          for( std :: uint64_t i = begin ; i < head ; ++ i ){
+            const std :: atomic< std :: uint64_t >* word = ring -> words + (i % CAPACITY) * 3;
+            const std :: uint64_t start = word[ 0 ].load( std :: memory_order_relaxed );
+            const std :: uint64_t bits  = word[ 1 ].load( std :: memory_order_relaxed );
+            const std :: uint64_t where = word[ 2 ].load( std :: memory_order_relaxed );
+            later = later || start > to;
+            if( start < from || start > to )
+              continue;
+            output.push_back( Event{ start, static_cast< std :: uint32_t >( bits >> 32 ), static_cast< std :: uint32_t >( bits )
+                                   , static_cast< Address >( where ), static_cast< Stage >( where >> 32 ), ring -> thread } );
+            indices.push_back( i );
+          }
+
+          // events overwritten while copying, including the one being written now, are removed.
+          // they are the oldest, at the front of copied events. ring of exited thread is not written
+          std :: atomic_thread_fence( std :: memory_order_acquire );
+          const std :: uint64_t after   = ring -> head.load( std :: memory_order_relaxed );
+          const std :: uint64_t valid   = exited ? begin : after + 1 > CAPACITY ? after + 1 - CAPACITY : 0;
+          const size_type       removed = static_cast< size_type >( std :: lower_bound( indices.begin(), indices.end(), valid ) - indices.begin() );
+          output.erase( output.begin() + static_cast< std :: ptrdiff_t >( mark )
+                      , output.begin() + static_cast< std :: ptrdiff_t >( mark + removed ) );
+
+          if( exited && ! later )
+            exported.push_back( ring );
+        }
+
+        if( ! exported.empty() ){
+          std :: lock_guard< std :: mutex > lock( registry().mutex );
+          std :: vector< std :: shared_ptr< Ring > >& all = registry().rings;
+          all.erase( std :: remove_if( all.begin(), all.end(), [ &exported ]( const std :: shared_ptr< Ring >& ring ){
+              return std :: find( exported.begin(), exported.end(), ring ) != exported.end();
+            } ), all.end() );
+        }
+
+        std :: sort( output.begin() + static_cast< std :: ptrdiff_t >( first ), output.end()
+            , []( const Event& lhs, const Event& rhs ){ return lhs.start < rhs.start; } );
+      }
+
+
+      /**
+       * @brief write events in a time window as Chrome trace event JSON
+       *
+       * @param[out]  output  JSON is written
+       * @param[in]   from    first time of window
+       * @param[in]   to      last time of window
+       * @return              number of written events
+       */
+      static size_type write_chrome( std :: ostream& output, const std :: uint64_t from, const std :: uint64_t to ){
+
+        // names first, collect() may drop rings of exited threads
+        const std :: vector< std :: pair< std :: uint32_t, std :: string > > names = threads();
+
+        std :: vector< Event > events;
+        collect( from, to, events );
+
+        output << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        bool first = true;
+        for( const std :: pair< std :: uint32_t, std :: string >& thread : names ){
+          output << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.first
+                 << ",\"args\":{\"name\":\"" << escape( thread.second ) << "\"}}";
+          first = false;
+        }
+
+        char buffer[ 64 ];
+        for( const Event& event : events ){
+          output << (first ? "" : ",") << "\n{\"name\":\"" << stage_name( event.stage ) << "\",\"cat\":\"SimpleControl\",\"ph\":\""
+                 << (event.duration == 0 ? "i\",\"s\":\"t" : "X") << "\",\"pid\":1,\"tid\":" << event.thread;
+          microseconds( event.start, buffer );
+          output << ",\"ts\":" << buffer;
+          if( event.duration != 0 ){
+            microseconds( event.duration, buffer );
+            output << ",\"dur\":" << buffer;
+          }
+          output << ",\"args\":{\"address\":" << event.address << ",\"count\":" << event.count << "}}";
+          first = false;
+        }
+
+        output << "\n]}\n";
+        return events.size();
+      }
+
+      /**
+       * @brief write events in a time window as Perfetto Trace protobuf
+       *
+       * @param[out]  output  binary protobuf is written, open the stream in binary mode
+       * @param[in]   from    first time of window
+       * @param[in]   to      last time of window
+       * @return              number of written events
+       */
+      static size_type write_perfetto( std :: ostream& output, const std :: uint64_t from, const std :: uint64_t to ){
+
+        // field numbers of perfetto/trace protos
+        constexpr std :: uint32_t TRACE_PACKET        = 1;  // Trace.packet
+        constexpr std :: uint32_t TIMESTAMP           = 8;  // TracePacket.timestamp
+        constexpr std :: uint32_t SEQUENCE_ID         = 10; // TracePacket.trusted_packet_sequence_id
+        constexpr std :: uint32_t TRACK_EVENT         = 11; // TracePacket.track_event
+        constexpr std :: uint32_t TRACK_DESCRIPTOR    = 60; // TracePacket.track_descriptor
+        constexpr std :: uint32_t DESCRIPTOR_UUID     = 1;  // TrackDescriptor.uuid
+        constexpr std :: uint32_t DESCRIPTOR_NAME     = 2;  // TrackDescriptor.name
+        constexpr std :: uint32_t EVENT_TYPE          = 9;  // TrackEvent.type
+        constexpr std :: uint32_t EVENT_TRACK         = 11; // TrackEvent.track_uuid
+        constexpr std :: uint32_t EVENT_NAME          = 23; // TrackEvent.name
+        constexpr std :: uint32_t EVENT_ANNOTATION    = 4;  // TrackEvent.debug_annotations
+        constexpr std :: uint32_t ANNOTATION_NAME     = 10; // DebugAnnotation.name
+        constexpr std :: uint32_t ANNOTATION_UINT     = 3;  // DebugAnnotation.uint_value
+        constexpr std :: uint64_t SLICE_BEGIN         = 1;  // TrackEvent.TYPE_SLICE_BEGIN
+        constexpr std :: uint64_t SLICE_END           = 2;  // TrackEvent.TYPE_SLICE_END
+        constexpr std :: uint64_t INSTANT             = 3;  // TrackEvent.TYPE_INSTANT
+        constexpr std :: uint64_t SEQUENCE            = 1;
+
+        // names first, collect() may drop rings of exited threads
+        const std :: vector< std :: pair< std :: uint32_t, std :: string > > names = threads();
+
+        std :: vector< Event > events;
+        collect( from, to, events );
+
+        std :: string packet, message, annotation;
+
+        for( const std :: pair< std :: uint32_t, std :: string >& thread : names ){
+          message.clear();
+          varint_field( message, DESCRIPTOR_UUID, thread.first );
+          bytes_field ( message, DESCRIPTOR_NAME, thread.second );
+          packet.clear();
+          bytes_field ( packet, TRACK_DESCRIPTOR, message );
+          varint_field( packet, SEQUENCE_ID, SEQUENCE );
+          bytes_field ( output, TRACE_PACKET, packet );
+        }
+
+        // slice end events are sorted with begin events by time, ends first at same time
+        struct Edge {
+          std :: uint64_t time;
+          const Event*    event;
+          std :: uint64_t type;
+        };
+        std :: vector< Edge > edges;
+        edges.reserve( events.size() * 2 );
+        for( const Event& event : events ){
+          if( event.duration == 0 )
+            edges.push_back( Edge{ event.start, &event, INSTANT } );
+          else {
+            edges.push_back( Edge{ event.start,                  &event, SLICE_BEGIN } );
+            edges.push_back( Edge{ event.start + event.duration, &event, SLICE_END } );
+          }
+        }
+        std :: stable_sort( edges.begin(), edges.end(), []( const Edge& lhs, const Edge& rhs ){
+            return lhs.time != rhs.time ? lhs.time < rhs.time : (lhs.type == SLICE_END) > (rhs.type == SLICE_END);
+          } );
+
+        for( const Edge& edge : edges ){
+
+          message.clear();
+          varint_field( message, EVENT_TYPE,  edge.type );
+          varint_field( message, EVENT_TRACK, edge.event -> thread );
+
+          if( edge.type != SLICE_END ){
+            bytes_field( message, EVENT_NAME, stage_name( edge.event -> stage ) );
+
+            annotation.clear();
+            bytes_field ( annotation, ANNOTATION_NAME, "address" );
+            varint_field( annotation, ANNOTATION_UINT, edge.event -> address );
+            bytes_field ( message, EVENT_ANNOTATION, annotation );
+
+            annotation.clear();
+            bytes_field ( annotation, ANNOTATION_NAME, "count" );
+            varint_field( annotation, ANNOTATION_UINT, edge.event -> count );
+            bytes_field ( message, EVENT_ANNOTATION, annotation );
+          }
+
+          packet.clear();
+          varint_field( packet, TIMESTAMP,   edge.time );
+          bytes_field ( packet, TRACK_EVENT, message );
+          varint_field( packet, SEQUENCE_ID, SEQUENCE );
+          bytes_field ( output, TRACE_PACKET, packet );
+        }
+
+        return events.size();
+      }
+
+
+    private:
+
+      /**
+       * @brief ids and names of threads
+       */
+      static std :: vector< std :: pair< std :: uint32_t, std :: string > > threads( void ){
+        std :: vector< std :: pair< std :: uint32_t, std :: string > > result;
+        std :: lock_guard< std :: mutex > lock( registry().mutex );
+        for( const std :: shared_ptr< Ring >& ring : registry().rings )
+          result.emplace_back( ring -> thread, ring -> name );
+        return result;
+      }
+
+      /**
+       * @brief name of stage
+       */
+      static const char* stage_name( const Stage stage ){
+        static const char* const names[ STAGES ] = { "encode", "enqueue", "write", "read", "parse", "decode", "dispatch" };
+        return stage < STAGES ? names[ stage ] : "unknown";
+      }
+
+      /**
+       * @brief nanoseconds as decimal microseconds
+       */
+      static void microseconds( const std :: uint64_t nanoseconds, char* output ){
+        const std :: string integer = std :: to_string( nanoseconds / 1000 );
+        const unsigned int  rest    = static_cast< unsigned int >( nanoseconds % 1000 );
+        std :: copy( integer.begin(), integer.end(), output );
+        output += integer.size();
+        *output ++ = '.';
+        *output ++ = static_cast< char >( '0' + rest / 100 );
+        *output ++ = static_cast< char >( '0' + rest / 10 % 10 );
+        *output ++ = static_cast< char >( '0' + rest % 10 );
+        *output    = '\0';
+      }
+
+      /**
+       * @brief JSON string escape
+       */
+      static std :: string escape( const std :: string& input ){
+        std :: string result;
+        for( const char c : input ){
+          if( c == '"' || c == '\\' )
+            result += '\\';
+          if( static_cast< unsigned char >( c ) >= 0x20 )
+            result += c;
+        }
+        return result;
+      }
+
+
+      /**
+       * @brief append protobuf varint
+       */
+      static void varint( std :: string& output, std :: uint64_t value ){
+        for( ; value >= 0x80 ; value >>= 7 )
+          output += static_cast< char >( (value & 0x7F) | 0x80 );
+        output += static_cast< char >( value );
+      }
+
+      /**
+       * @brief append protobuf varint field
+       */
+      static void varint_field( std :: string& output, const std :: uint32_t field, const std :: uint64_t value ){
+        varint( output, static_cast< std :: uint64_t >( field ) << 3 | 0 );
+        varint( output, value );
+      }
+
+      /**
+       * @brief append protobuf length delimited field
+       */
+      static void bytes_field( std :: string& output, const std :: uint32_t field, const std :: string& value ){
+        varint( output, static_cast< std :: uint64_t >( field ) << 3 | 2 );
+        varint( output, value.size() );
+        output += value;
+      }
+
+      /**
+       * @brief write protobuf length delimited field to stream
+       */
+      static void bytes_field( std :: ostream& output, const std :: uint32_t field, const std :: string& value ){
+        std :: string header;
+        varint( header, static_cast< std :: uint64_t >( field ) << 3 | 2 );
+        varint( header, value.size() );
+        output.write( header.data(), static_cast< std :: streamsize >( header.size() ) );
+        output.write( value.data(), static_cast< std :: streamsize >( value.size() ) );
+      }
+
+  };
+
+}
+
+#endif /* SimpleControlSimpleControl_Trace_h */
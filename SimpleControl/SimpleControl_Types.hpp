@@ -29,6 +29,15 @@ namespace SimpleControl {
     std :: uint32_t;
 # endif
 
+
+  /**
+   * @brief pair of Address and Data, a unit of SimpleControl message
+   */
+  struct Message {
+    Address address; ///< destination of data
+    Data    data;    ///< value
+  };
+
 }
 
 
@@ -93,7 +93,7 @@ int main( void ) {
   bool_print( address_test.is_data   () );
  
 
-  Serialized data_test{ 100, 127, 50, 79, 0b01110010 };
+  Serialized data_test{ 100, 127, 50, 79, 0b00000010 };
   bool_print( data_test.is_correct() );
   bool_print( data_test.is_address() );
   bool_print( data_test.is_data   () );
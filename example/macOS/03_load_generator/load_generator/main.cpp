@@ -0,0 +1,613 @@
+//
+//  main.cpp
+//  load_generator
+//
+//  Synthetic load generator and soak test of SimpleControl.
+//
+//  Sender thread simulates parameters with update patterns, encodes them and writes them into a local transport,
+//  receiver thread reads and decodes them on the other side, and reports are printed periodically.
+//
+//    load_generator [ options ]
+//      --transport pipe | pty | udp | shm   local transport                       ( pipe )
+//      --pattern   idle | burst | ramp | mixed  update distribution              ( mixed )
+//      --params    N                        number of parameters                 ( 1000 )
+//      --rate      N                        peak messages per second              ( 1000000 )
+//      --seconds   N                        duration, 0 runs until interrupted    ( 10 )
+//      --report    N                        seconds between reports              ( 1 )
+//
+//  Each tick ( 1 ms ) of messages ends with a marker message of `MARKER` Address, whose Data is sequence of the tick.
+//  Receiver compares number of messages before a marker with number sent in the tick to count drops,
+//  and latency of the tick is from its write to decode of its marker.
+//  Messages after a lost marker are counted against all ticks since the last received marker.
+//  The final summary shows latency percentiles of the whole run.
+//
+//  build without Xcode: c++ -std=c++14 -O2 -I../../../../SimpleControl main.cpp -o load_generator -lpthread
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "SimpleControl.hpp"
+#include "Serialized_FrameBuffer.hpp"
+
+namespace {
+
+  using Clock = std :: chrono :: steady_clock;
+
+  constexpr SimpleControl :: Address MARKER = 0xFFFFFFFF; ///< Address of tick marker
+  constexpr std :: size_t            TICKS  = 1 << 16;    ///< ticks kept for receiver
+  constexpr std :: size_t            CHUNK  = 8190;       ///< octets per write, multiple of message size
+
+  std :: atomic< bool > interrupted( false );
+
+  std :: uint64_t now( void ){
+    return static_cast< std :: uint64_t >( std :: chrono :: duration_cast< std :: chrono :: nanoseconds >( Clock :: now().time_since_epoch() ).count() );
+  }
+
+
+
+
+  /**
+   * @brief local transport, send() from sender thread and receive() from receiver thread
+   */
+  class Transport {
+    public:
+      virtual ~Transport( void ){}
+      virtual bool    send   ( const std :: uint8_t* data, std :: size_t length ) = 0; ///< false if octets are lost
+      virtual ssize_t receive( std :: uint8_t* data, std :: size_t capacity ) = 0;     ///< 0 after timeout
+  };
+
+
+  /**
+   * @brief transport by a pair of file descriptors, pipe or pty
+   */
+  class FdTransport : public Transport {
+
+      int _write;
+      int _read;
+
+    public:
+      FdTransport( const int write, const int read ) : _write( write ), _read( read ) {}
+      ~FdTransport( void ){ close( _write ); close( _read ); }
+
+      bool send( const std :: uint8_t* data, std :: size_t length ) override {
+        while( length != 0 ){
+          const ssize_t written = write( _write, data, length );
+          if( written < 0 )
+            return false;
+          data   += written;
+          length -= static_cast< std :: size_t >( written );
+        }
+        return true;
+      }
+
+      ssize_t receive( std :: uint8_t* data, const std :: size_t capacity ) override {
+        pollfd fd = { _read, POLLIN, 0 };
+        if( poll( &fd, 1, 100 ) <= 0 )
+          return 0;
+        return read( _read, data, capacity );
+      }
+
+      static std :: unique_ptr< Transport > pipe( void ){
+        int fds[ 2 ];
+        if( :: pipe( fds ) != 0 )
+          return nullptr;
+        return std :: unique_ptr< Transport >( new FdTransport( fds[ 1 ], fds[ 0 ] ) );
+      }
+
+      static std :: unique_ptr< Transport > pty( void ){
+        const int master = posix_openpt( O_RDWR | O_NOCTTY );
+        if( master < 0 || grantpt( master ) != 0 || unlockpt( master ) != 0 )
+          return nullptr;
+        const int slave = open( ptsname( master ), O_RDWR | O_NOCTTY );
+        if( slave < 0 )
+          return nullptr;
+
+        // raw 8 bit link like a serial port
+        termios mode;
+        tcgetattr( slave, &mode );
+        cfmakeraw( &mode );
+        tcsetattr( slave, TCSANOW, &mode );
+        return std :: unique_ptr< Transport >( new FdTransport( master, slave ) );
+      }
+  };
+
+
+  /**
+   * @brief transport by loopback UDP, a write is a datagram
+   */
+  class UdpTransport : public Transport {
+
+      int         _send;
+      int         _receive;
+      sockaddr_in _address;
+
+    public:
+      UdpTransport( void ) : _send( socket( AF_INET, SOCK_DGRAM, 0 ) ), _receive( socket( AF_INET, SOCK_DGRAM, 0 ) ), _address() {
+        _address.sin_family      = AF_INET;
+        _address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        _address.sin_port        = 0;
+
+        const int size = 8 << 20;
+        setsockopt( _receive, SOL_SOCKET, SO_RCVBUF, &size, sizeof( size ) );
+
+        socklen_t length = sizeof( _address );
+        bind( _receive, reinterpret_cast< sockaddr* >( &_address ), length );
+        getsockname( _receive, reinterpret_cast< sockaddr* >( &_address ), &length );
+      }
+      ~UdpTransport( void ){ close( _send ); close( _receive ); }
+
+      bool send( const std :: uint8_t* data, const std :: size_t length ) override {
+        return sendto( _send, data, length, 0, reinterpret_cast< const sockaddr* >( &_address ), sizeof( _address ) ) == static_cast< ssize_t >( length );
+      }
+
+      ssize_t receive( std :: uint8_t* data, const std :: size_t capacity ) override {
+        pollfd fd = { _receive, POLLIN, 0 };
+        if( poll( &fd, 1, 100 ) <= 0 )
+          return 0;
+        return recv( _receive, data, capacity, 0 );
+      }
+  };
+
+
+  /**
+   * @brief transport by a single producer single consumer ring in shared memory
+   */
+  class ShmTransport : public Transport {
+
+      constexpr static std :: size_t SIZE = 1 << 22;
+
+      struct Ring {
+        alignas( 64 ) std :: atomic< std :: uint64_t > head; ///< next octet to read
+        alignas( 64 ) std :: atomic< std :: uint64_t > tail; ///< next octet to write
+        alignas( 64 ) std :: uint8_t                   data[ SIZE ];
+      };
+
+      Ring* _ring;
+
+    public:
+      ShmTransport( void ) : _ring( nullptr ) {
+        const char* name = "/load_generator";
+        const int   fd   = shm_open( name, O_CREAT | O_RDWR, 0600 );
+        shm_unlink( name );
+        if( fd < 0 || ftruncate( fd, sizeof( Ring ) ) != 0 )
+          return;
+        void* memory = mmap( nullptr, sizeof( Ring ), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        close( fd );
+        if( memory == MAP_FAILED )
+          return;
+        _ring = static_cast< Ring* >( memory );
+        new ( &_ring -> head ) std :: atomic< std :: uint64_t >( 0 );
+        new ( &_ring -> tail ) std :: atomic< std :: uint64_t >( 0 );
+      }
+      ~ShmTransport( void ){ if( _ring != nullptr ) munmap( _ring, sizeof( Ring ) ); }
+
+      bool valid( void ) const { return _ring != nullptr; }
+
+      bool send( const std :: uint8_t* data, std :: size_t length ) override {
+        const std :: uint64_t tail = _ring -> tail.load( std :: memory_order_relaxed );
+        while( tail + length - _ring -> head.load( std :: memory_order_acquire ) > SIZE ){
+          if( interrupted )
+            return false;
+          std :: this_thread :: yield();
+        }
+        for( std :: size_t i = 0 ; i < length ; ){
+          const std :: size_t offset = (tail + i) % SIZE;
+          const std :: size_t n      = std :: min( length - i, SIZE - offset );
+          std :: memcpy( _ring -> data + offset, data + i, n );
+          i += n;
+        }
+        _ring -> tail.store( tail + length, std :: memory_order_release );
+        return true;
+      }
+
+      ssize_t receive( std :: uint8_t* data, const std :: size_t capacity ) override {
+        const std :: uint64_t head  = _ring -> head.load( std :: memory_order_relaxed );
+        const Clock :: time_point limit = Clock :: now() + std :: chrono :: milliseconds( 100 );
+        std :: uint64_t tail;
+        while( (tail = _ring -> tail.load( std :: memory_order_acquire )) == head ){
+          if( Clock :: now() > limit )
+            return 0;
+          std :: this_thread :: yield();
+        }
+        const std :: size_t offset = head % SIZE;
+        const std :: size_t n      = std :: min< std :: size_t >( { static_cast< std :: size_t >( tail - head ), capacity, SIZE - offset } );
+        std :: memcpy( data, _ring -> data + offset, n );
+        _ring -> head.store( head + n, std :: memory_order_release );
+        return static_cast< ssize_t >( n );
+      }
+  };
+
+
+
+
+  /**
+   * @brief options of a run
+   */
+  struct Options {
+    std :: string   transport = "pipe";
+    std :: string   pattern   = "mixed";
+    std :: uint32_t params    = 1000;
+    double          rate      = 1000000;
+    double          seconds   = 10;
+    double          report    = 1;
+  };
+
+
+  /**
+   * @brief update pattern of parameters, fills messages of a tick
+   */
+  class Pattern {
+
+      const Options&              _options;
+      std :: mt19937              _random;
+      std :: vector< float >      _values;
+      double                      _carry;     ///< fraction of messages carried to next tick
+      std :: uint64_t             _tick;
+      std :: uint64_t             _burst_end; ///< tick of end of current burst
+      std :: uint32_t             _burst_base;///< first parameter of current burst
+      std :: uint32_t             _ramp;      ///< next parameter of ramp
+
+    public:
+      explicit Pattern( const Options& options ) :
+          _options( options ), _random( 1 ), _values( options.params, 0 ), _carry( 0 ), _tick( 0 ), _burst_end( 0 ), _burst_base( 0 ), _ramp( 0 ) {}
+
+      void tick( std :: vector< SimpleControl :: Message >& output ){
+
+        const std :: string& name  = _options.pattern;
+        const double         peak  = _options.rate / 1000;
+        const std :: uint32_t n    = _options.params;
+
+        // share of peak rate used by each distribution in this tick
+        double idle  = name == "idle"  ? 0.01 : name == "mixed" ? 0.01 : 0;
+        double burst = 0;
+        double ramp  = name == "ramp"  ? 1    : name == "mixed" ? 0.3  : 0;
+
+        if( name == "burst" || name == "mixed" ){
+          if( _tick >= _burst_end && std :: uniform_real_distribution< double >( 0, 1 )( _random ) < 0.002 ){
+            _burst_end  = _tick + 50 + _random() % 400;
+            _burst_base = _random() % n;
+          }
+          burst = _tick < _burst_end ? (name == "burst" ? 1 : 0.69) : 0;
+        }
+
+        const double   total = (idle + burst + ramp) * peak + _carry;
+        const std :: size_t count = static_cast< std :: size_t >( total );
+        _carry = total - count;
+
+        for( std :: size_t i = 0 ; i < count ; ++ i ){
+          const double   pick = std :: uniform_real_distribution< double >( 0, idle + burst + ramp )( _random );
+          std :: uint32_t index;
+          if( pick < idle ){
+            index = _random() % n;
+            _values[ index ] = std :: uniform_real_distribution< float >( 0, 1 )( _random );
+          }
+          else if( pick < idle + burst ){
+            index = (_burst_base + _random() % 16) % n;
+            _values[ index ] = std :: min( 1.0f, std :: max( 0.0f, _values[ index ] + std :: normal_distribution< float >( 0, 0.01f )( _random ) ) );
+          }
+          else {
+            index = _ramp;
+            _ramp = (_ramp + 1) % n;
+            _values[ index ] = std :: fmod( _values[ index ] + 0.001f, 1.0f );
+          }
+          output.push_back( SimpleControl :: Message{ index, _values[ index ] } );
+        }
+
+        ++ _tick;
+      }
+  };
+
+
+  /**
+   * @brief latency histogram, 16 sub buckets per power of 2 nanoseconds
+   */
+  class Histogram {
+
+      std :: vector< std :: uint64_t > _buckets;
+      std :: uint64_t                  _count;
+      std :: uint64_t                  _max;
+
+      static std :: size_t bucket( const std :: uint64_t value ){
+        if( value < 16 )
+          return static_cast< std :: size_t >( value );
+        const unsigned int power = 63 - __builtin_clzll( value );
+        return (power - 3) * 16 + static_cast< std :: size_t >( (value >> (power - 4)) & 15 );
+      }
+
+      static std :: uint64_t lower( const std :: size_t index ){
+        if( index < 16 )
+          return index;
+        const unsigned int power = static_cast< unsigned int >( index / 16 + 3 );
+        return (static_cast< std :: uint64_t >( 16 + index % 16 )) << (power - 4);
+      }
+
+    public:
+      Histogram( void ) : _buckets( 64 * 16, 0 ), _count( 0 ), _max( 0 ) {}
+
+      void add( const std :: uint64_t value ){ ++ _buckets[ bucket( value ) ]; ++ _count; _max = std :: max( _max, value ); }
+
+      void clear( void ){ std :: fill( _buckets.begin(), _buckets.end(), 0 ); _count = 0; _max = 0; }
+
+      void merge( const Histogram& other ){
+        for( std :: size_t i = 0 ; i < _buckets.size() ; ++ i )
+          _buckets[ i ] += other._buckets[ i ];
+        _count += other._count;
+        _max    = std :: max( _max, other._max );
+      }
+
+      std :: uint64_t count( void ) const { return _count; }
+      std :: uint64_t max  ( void ) const { return _max; }
+
+      std :: uint64_t percentile( const double p ) const {
+        const std :: uint64_t rank = static_cast< std :: uint64_t >( std :: ceil( p / 100 * _count ) );
+        std :: uint64_t       sum  = 0;
+        for( std :: size_t i = 0 ; i < _buckets.size() ; ++ i )
+          if( (sum += _buckets[ i ]) >= rank && rank != 0 )
+            return lower( i );
+        return _max;
+      }
+  };
+
+
+  /**
+   * @brief a tick written by sender
+   */
+  struct Tick {
+    std :: atomic< std :: uint64_t > time;  ///< time of write
+    std :: atomic< std :: uint32_t > count; ///< number of messages before marker
+  };
+
+
+  /**
+   * @brief counters of receiver
+   */
+  struct Counters {
+    std :: atomic< std :: uint64_t > sent;     ///< messages written by sender, without markers
+    std :: atomic< std :: uint64_t > octets;   ///< octets written by sender
+    std :: atomic< std :: uint64_t > failed;   ///< writes failed or lost by transport
+    std :: atomic< std :: uint64_t > received; ///< decoded messages, without markers
+    std :: atomic< std :: uint64_t > dropped;  ///< messages not received before a marker
+    std :: atomic< std :: uint64_t > invalid;  ///< invalid frames found by parser
+  };
+
+
+  void sender( const Options& options, Transport& transport, Tick* ticks, Counters& counters, std :: atomic< bool >& done ){
+
+    Pattern                                  pattern( options );
+    SimpleControl :: FrameBuffer              frames( static_cast< std :: size_t >( options.rate / 1000 ) + 1 );
+    std :: vector< SimpleControl :: Message > messages;
+
+    const Clock :: time_point start = Clock :: now();
+    std :: uint32_t           sequence = 0;
+
+    for( std :: uint64_t tick = 0 ; ! done ; ++ tick ){
+
+      std :: this_thread :: sleep_until( start + std :: chrono :: milliseconds( tick ) );
+
+      messages.clear();
+      pattern.tick( messages );
+
+      const std :: uint32_t count = static_cast< std :: uint32_t >( messages.size() );
+      messages.push_back( SimpleControl :: Message{ MARKER, static_cast< SimpleControl :: Data >( sequence & 0xFFFFFF ) } );
+
+      frames.clear();
+      frames.append( messages.data(), messages.size() );
+
+      Tick& entry = ticks[ sequence % TICKS ];
+      entry.count.store( count, std :: memory_order_relaxed );
+      entry.time .store( now(), std :: memory_order_release );
+
+      for( std :: size_t offset = 0 ; offset < frames.octet_size() ; offset += CHUNK ){
+        const std :: size_t length = std :: min( CHUNK, frames.octet_size() - offset );
+        if( ! transport.send( frames.octets() + offset, length ) )
+          counters.failed.fetch_add( 1, std :: memory_order_relaxed );
+      }
+
+      counters.sent  .fetch_add( count, std :: memory_order_relaxed );
+      counters.octets.fetch_add( frames.octet_size(), std :: memory_order_relaxed );
+      ++ sequence;
+    }
+  }
+
+
+  void receiver( Transport& transport, Tick* ticks, Counters& counters, Histogram& latency, std :: atomic< bool >& latency_lock, std :: atomic< bool >& done ){
+
+    SimpleControl :: Serialized_Parser        parser;
+    std :: vector< std :: uint8_t >           input( 1 << 16 );
+    std :: vector< SimpleControl :: Message > output( input.size() / SimpleControl :: Serialized :: SIZE + 1 );
+
+    std :: uint32_t expected = 0;     ///< sequence of next marker
+    std :: uint32_t since    = 0;     ///< messages after last marker
+    bool            first    = true;
+
+    while( ! done ){
+
+      const ssize_t length = transport.receive( input.data(), input.size() );
+      if( length <= 0 )
+        continue;
+
+      std :: size_t offset = 0;
+      while( offset < static_cast< std :: size_t >( length ) ){
+
+        std :: size_t count = 0;
+        offset += parser.parse( input.data() + offset, static_cast< std :: size_t >( length ) - offset, output.data(), output.size(), count );
+
+        for( std :: size_t i = 0 ; i < count ; ++ i ){
+
+          if( output[ i ].address != MARKER ){
+            ++ since;
+            continue;
+          }
+
+          const std :: uint64_t arrival = now();
+          const std :: uint32_t low     = static_cast< std :: uint32_t >( output[ i ].data );
+          std :: uint32_t       sequence = (expected & ~0xFFFFFFu) | low;
+          if( sequence < expected )
+            sequence += 0x1000000;
+          if( first ){
+            expected = sequence;
+            first    = false;
+          }
+
+          // messages since last marker belong to ticks whose markers are lost and to this tick
+          std :: uint64_t want = 0;
+          for( ; expected != sequence && sequence - expected < TICKS ; ++ expected )
+            want += ticks[ expected % TICKS ].count.load( std :: memory_order_relaxed );
+
+          const Tick& tick = ticks[ sequence % TICKS ];
+          const std :: uint64_t sent    = tick.time.load( std :: memory_order_acquire );
+          want += tick.count.load( std :: memory_order_relaxed );
+          const std :: uint64_t dropped = want > since ? want - since : 0;
+
+          while( latency_lock.exchange( true, std :: memory_order_acquire ) ) ;
+          latency.add( arrival - sent );
+          latency_lock.store( false, std :: memory_order_release );
+
+          counters.received.fetch_add( since, std :: memory_order_relaxed );
+          counters.dropped .fetch_add( dropped, std :: memory_order_relaxed );
+          since    = 0;
+          expected = sequence + 1;
+        }
+      }
+
+      counters.invalid.store( parser.invalid(), std :: memory_order_relaxed );
+    }
+  }
+
+
+  bool parse_options( const int argc, const char* const argv[], Options& options ){
+    for( int i = 1 ; i + 1 < argc ; i += 2 ){
+      const std :: string key   = argv[ i ];
+      const char*         value = argv[ i + 1 ];
+      if     ( key == "--transport" ) options.transport = value;
+      else if( key == "--pattern" )   options.pattern   = value;
+      else if( key == "--params" )    options.params    = static_cast< std :: uint32_t >( std :: strtoul( value, nullptr, 10 ) );
+      else if( key == "--rate" )      options.rate      = std :: strtod( value, nullptr );
+      else if( key == "--seconds" )   options.seconds   = std :: strtod( value, nullptr );
+      else if( key == "--report" )    options.report    = std :: strtod( value, nullptr );
+      else
+        return false;
+    }
+    return (argc % 2) == 1 && options.params != 0 && options.rate > 0 && options.report > 0
+        && (options.pattern == "idle" || options.pattern == "burst" || options.pattern == "ramp" || options.pattern == "mixed");
+  }
+
+}
+
+
+
+
+int main( int argc, const char * argv[] ) {
+
+  Options options;
+  if( ! parse_options( argc, argv, options ) ){
+    std :: fprintf( stderr, "usage: %s [ --transport pipe|pty|udp|shm ] [ --pattern idle|burst|ramp|mixed ] [ --params N ] [ --rate N ] [ --seconds N ] [ --report N ]\n", argv[ 0 ] );
+    return 1;
+  }
+
+  std :: unique_ptr< Transport > transport;
+  if     ( options.transport == "pipe" ) transport = FdTransport :: pipe();
+  else if( options.transport == "pty" )  transport = FdTransport :: pty();
+  else if( options.transport == "udp" )  transport.reset( new UdpTransport() );
+  else if( options.transport == "shm" ){
+    std :: unique_ptr< ShmTransport > shm( new ShmTransport() );
+    if( shm -> valid() )
+      transport = std :: move( shm );
+  }
+  if( ! transport ){
+    std :: fprintf( stderr, "transport %s is not available\n", options.transport.c_str() );
+    return 1;
+  }
+
+  std :: signal( SIGINT, []( int ){ interrupted = true; } );
+
+  std :: unique_ptr< Tick[] > ticks( new Tick[ TICKS ]() );
+  Counters                    counters = {};
+  Histogram                   latency;
+  Histogram                   total;
+  std :: atomic< bool >       latency_lock( false );
+  std :: atomic< bool >       sending( false ), receiving( false );
+
+  std :: thread receive_thread( [ & ]{ receiver( *transport, ticks.get(), counters, latency, latency_lock, receiving ); } );
+  std :: thread send_thread   ( [ & ]{ sender  ( options, *transport, ticks.get(), counters, sending ); } );
+
+  std :: printf( "transport %s, pattern %s, %u parameters, peak %.0f messages/s\n", options.transport.c_str(), options.pattern.c_str(), options.params, options.rate );
+  std :: printf( "%8s %12s %10s %10s %10s %8s %10s %10s %10s %10s\n", "time", "messages/s", "MB/s", "dropped", "failed", "invalid", "p50 us", "p99 us", "p99.9 us", "max us" );
+
+  const Clock :: time_point start = Clock :: now();
+  std :: uint64_t           last_received = 0, last_octets = 0;
+
+  for( int report = 1 ; ! interrupted ; ++ report ){
+
+    const Clock :: time_point at = start + std :: chrono :: duration_cast< Clock :: duration >( std :: chrono :: duration< double >( options.report * report ) );
+    while( Clock :: now() < at && ! interrupted )
+      std :: this_thread :: sleep_for( std :: chrono :: milliseconds( 10 ) );
+
+    const std :: uint64_t received = counters.received.load();
+    const std :: uint64_t octets   = counters.octets.load();
+
+    while( latency_lock.exchange( true, std :: memory_order_acquire ) ) ;
+    const double p50 = latency.percentile( 50 ) / 1e3, p99 = latency.percentile( 99 ) / 1e3, p999 = latency.percentile( 99.9 ) / 1e3, max = latency.max() / 1e3;
+    total.merge( latency );
+    latency.clear();
+    latency_lock.store( false, std :: memory_order_release );
+
+    std :: printf( "%8.1f %12.0f %10.2f %10llu %10llu %8llu %10.1f %10.1f %10.1f %10.1f\n"
+        , options.report * report
+        , (received - last_received) / options.report
+        , (octets - last_octets) / options.report / 1e6
+        , static_cast< unsigned long long >( counters.dropped.load() )
+        , static_cast< unsigned long long >( counters.failed.load() )
+        , static_cast< unsigned long long >( counters.invalid.load() )
+        , p50, p99, p999, max );
+    std :: fflush( stdout );
+
+    last_received = received;
+    last_octets   = octets;
+
+    if( options.seconds > 0 && options.report * report >= options.seconds )
+      break;
+  }
+
+  sending = true;
+  send_thread.join();
+  std :: this_thread :: sleep_for( std :: chrono :: milliseconds( 200 ) );
+  receiving = true;
+  receive_thread.join();
+  total.merge( latency );
+
+  std :: printf( "total sent %llu, received %llu, dropped %llu, failed writes %llu, invalid frames %llu\n"
+      , static_cast< unsigned long long >( counters.sent.load() )
+      , static_cast< unsigned long long >( counters.received.load() )
+      , static_cast< unsigned long long >( counters.dropped.load() )
+      , static_cast< unsigned long long >( counters.failed.load() )
+      , static_cast< unsigned long long >( counters.invalid.load() ) );
+  std :: printf( "total latency of %llu ticks, p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n"
+      , static_cast< unsigned long long >( total.count() )
+      , total.percentile( 50 ) / 1e3, total.percentile( 99 ) / 1e3, total.percentile( 99.9 ) / 1e3, total.max() / 1e3 );
+
+  return 0;
+}
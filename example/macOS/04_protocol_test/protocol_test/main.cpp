@@ -0,0 +1,2041 @@
+//
+//  main.cpp
+//  protocol_test
+//
+//  Round trip, corruption and equivalence checks of SimpleControl frames and helper classes.
+//
+//    protocol_test [ name ... ]   runs named tests, all tests without arguments
+//
+//  Each test prints its failed checks and a summary line, exit status is 1 if any check failed.
+//  Random inputs are generated from a fixed seed, so failures are reproducible.
+//
+//  build without Xcode: c++ -std=c++14 -O2 -I../../../../SimpleControl main.cpp -o protocol_test -lpthread
+//  async test of Serialized_AsyncReceiver is built with -std=c++20 on Linux.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "SimpleControl.hpp"
+#include "Serialized_AsyncReceiver.hpp"
+#include "Serialized_CreditSender.hpp"
+#include "Serialized_FrameBuffer.hpp"
+#include "Serialized_ParallelDecoder.hpp"
+#include "Serialized_PrioritySender.hpp"
+#include "Serialized_ReceivePipeline.hpp"
+#include "Serialized_SysExSender.hpp"
+#include "Serialized_Router.hpp"
+#include "Serialized_StateSync.hpp"
+#include "SimpleControl_BlockEvents.hpp"
+#include "SimpleControl_OscBridge.hpp"
+#include "SimpleControl_ParameterSmoother.hpp"
+#include "SimpleControl_Pool.hpp"
+#include "SimpleControl_Schema.hpp"
+#include "SimpleControl_SharedTable.hpp"
+#include "SimpleControl_SubscriptionIndex.hpp"
+#include "SimpleControl_Trace.hpp"
+
+namespace {
+
+  using namespace SimpleControl;
+
+  using Octets = std :: vector< Serialized :: value_type >;
+
+  std :: size_t checks = 0; ///< number of checks in current test
+  std :: size_t failed = 0; ///< number of failed checks in current test
+
+
+  /**
+   * @brief count a check, print it if failed
+   */
+  bool check( const bool condition, const char* what, const long long detail = 0 ){
+    ++ checks;
+    if( ! condition ){
+      ++ failed;
+      std :: printf( "  failed: %s ( %lld )\n", what, detail );
+    }
+    return condition;
+  }
+
+  /**
+   * @brief same bits of two Data, NaN compares equal to itself
+   */
+  bool same( const Data a, const Data b ){
+    return std :: memcmp( &a, &b, sizeof( Data ) ) == 0;
+  }
+
+  /**
+   * @brief random Data of any bit pattern
+   */
+  Data random_data( std :: mt19937& random ){
+    const std :: uint32_t bits = random();
+    Data result;
+    std :: memcpy( &result, &bits, sizeof( Data ) );
+    return result;
+  }
+
+  /**
+   * @brief append octets of a frame
+   */
+  template < typename Frame >
+  void append( Octets& output, const Frame& frame ){
+    for( std :: size_t i = 0 ; i < Frame :: SIZE ; ++ i )
+      output.push_back( frame[ i ] );
+  }
+
+  /**
+   * @brief append Address and Data frames of a message
+   */
+  void append( Octets& output, const Message& message ){
+    append( output, Serialized( message.address ) );
+    append( output, Serialized( message.data    ) );
+  }
+
+  /**
+   * @brief decode octets by Serialized_Parser
+   */
+  std :: vector< Message > parse( const Octets& input ){
+    Serialized_Parser        parser;
+    std :: vector< Message > result;
+    Message                  message;
+    for( const Serialized :: value_type octet : input )
+      if( parser.parse( octet, message ) )
+        result.push_back( message );
+    return result;
+  }
+
+  /**
+   * @brief same Address and Data bits of message arrays
+   */
+  bool same( const std :: vector< Message >& a, const std :: vector< Message >& b ){
+    if( a.size() != b.size() )
+      return false;
+    for( std :: size_t i = 0 ; i < a.size() ; ++ i )
+      if( a[ i ].address != b[ i ].address || ! same( a[ i ].data, b[ i ].data ) )
+        return false;
+    return true;
+  }
+
+
+
+
+  /**
+   * @brief random messages, Address is one of `addresses` values from 0
+   */
+  std :: vector< Message > random_messages( std :: mt19937& random, const std :: size_t count, const Address addresses ){
+    std :: vector< Message > result( count );
+    for( Message& message : result ){
+      message.address = random() % addresses;
+      message.data    = random_data( random );
+    }
+    return result;
+  }
+
+
+
+  /**
+   * @brief Serialized_Bulk round trip of array sizes, truncated and corrupted frames
+   */
+  void test_bulk( void ){
+
+    std :: mt19937 random( 26 );
+
+    const std :: size_t counts[] = { 0, 1, 2, 6, 7, 8, 16, 100, 512, Serialized_Bulk :: MAX_COUNT };
+
+    for( const std :: size_t count : counts ){
+
+      std :: vector< Data > input( count );
+      for( Data& data : input )
+        data = random_data( random );
+
+      Octets frame( Serialized_Bulk :: size( count ) );
+      const Address address = random();
+
+      if( ! check( Serialized_Bulk :: encode( address, input.data(), count, frame.data() ) == frame.size(), "bulk encode size", count ) )
+        continue;
+
+      check( Serialized_Bulk :: is_bulk( frame.data(), frame.size() ),  "bulk is_bulk",      count );
+      check( Serialized_Bulk :: count  ( frame.data() ) == count,       "bulk count",        count );
+
+      bool clean = true;
+      for( std :: size_t i = Serialized_Bulk :: HEADER_SIZE ; i < frame.size() ; ++ i )
+        clean = clean && frame[ i ] < 0x80;
+      check( clean, "bulk payload without header bit", count );
+
+      std :: vector< Data > output( count + 1 );
+      Address               decoded = 0;
+
+      check( Serialized_Bulk :: decode( frame.data(), frame.size(), decoded, output.data(), output.size() ) == frame.size(), "bulk decode size", count );
+      check( decoded == address, "bulk Address", count );
+
+      bool equal = true;
+      for( std :: size_t i = 0 ; i < count ; ++ i )
+        equal = equal && same( input[ i ], output[ i ] );
+      check( equal, "bulk Data", count );
+
+      check( Serialized_Bulk :: decode( frame.data(), frame.size() - 1, decoded, output.data(), output.size() ) == 0, "bulk truncated", count );
+
+      if( count == 0 )
+        continue;
+
+      check( Serialized_Bulk :: decode( frame.data(), frame.size(), decoded, output.data(), count - 1 ) == 0, "bulk over capacity", count );
+
+      frame[ frame.size() - 1 ] |= 0x80;
+      check( Serialized_Bulk :: decode( frame.data(), frame.size(), decoded, output.data(), output.size() ) == 0, "bulk header bit in payload", count );
+    }
+
+    std :: vector< Data > over( Serialized_Bulk :: MAX_COUNT + 1 );
+    Octets                frame( Serialized_Bulk :: size( over.size() ) );
+    check( Serialized_Bulk :: encode( 0, over.data(), over.size(), frame.data() ) == 0, "bulk over MAX_COUNT" );
+  }
+
+
+
+  /**
+   * @brief Serialized_Quantized round trip of fixed point values, quantized Data and clamp
+   */
+  template < unsigned int BITS >
+  void test_quantized( const std :: uint32_t step ){
+
+    using Quantized = Serialized_Quantized< BITS >;
+
+    Quantized frame;
+
+    bool equal = true;
+    bool clean = true;
+    for( std :: uint32_t value = 0 ; value <= Quantized :: MAX ; value += step ){
+      std :: uint32_t decoded = 0;
+      frame.encode( value );
+      frame.decode( decoded );
+      clean = clean && frame.is_quantized();
+      equal = equal && decoded == value;
+    }
+    frame.encode( Quantized :: MAX );
+    std :: uint32_t decoded = 0;
+    frame.decode( decoded );
+    check( clean,                      "quantized frame without header bit", BITS );
+    check( equal,                      "quantized fixed point value",        BITS );
+    check( decoded == Quantized :: MAX, "quantized MAX",                      BITS );
+
+    const Quantize quantize = Quantized :: range( -1.0f, 1.0f );
+    std :: mt19937 random( BITS );
+    std :: uniform_real_distribution< Data > distribution( -1.0f, 1.0f );
+
+    Data error = 0;
+    for( int i = 0 ; i < 100000 ; ++ i ){
+      const Data input = distribution( random );
+      Data       output;
+      frame.encode( input, quantize );
+      frame.decode( output, quantize );
+      error = std :: max( error, std :: fabs( output - input ) );
+    }
+    check( error <= quantize.scale * 0.5f + 4 * std :: numeric_limits< Data > :: epsilon(), "quantized error within half step", BITS );
+
+    Data output;
+    frame.encode( -2.0f, quantize );
+    frame.decode( output, quantize );
+    check( output == -1.0f, "quantized clamp to minimum", BITS );
+    frame.encode( 2.0f, quantize );
+    frame.decode( output, quantize );
+    check( std :: fabs( output - 1.0f ) <= quantize.scale, "quantized clamp to maximum", BITS );
+    frame.encode( std :: numeric_limits< Data > :: quiet_NaN(), quantize );
+    frame.decode( output, quantize );
+    check( output == -1.0f, "quantized NaN to minimum", BITS );
+
+    Serialized header;
+    Address    address = 0;
+    header.encode( static_cast< Address >( 0x89ABCDEF ), Quantized :: KIND );
+    header.decode( address );
+    check( header.is_address( Quantized :: KIND ) && ! header.is_address(), "quantized header kind", BITS );
+    check( address == 0x89ABCDEF,                                           "quantized header Address", BITS );
+  }
+
+  void test_quantized( void ){
+    test_quantized< 14 >( 1 );
+    test_quantized< 21 >( 7 );
+  }
+
+
+
+  /**
+   * @brief Serialized_Short round trip of Address boundaries, truncated and malformed frames, and short link stream
+   */
+  void test_short( void ){
+
+    std :: vector< Address > addresses = { 0, 0xFFFFFFFF };
+    for( unsigned int bits = 6 ; bits < 32 ; bits += 6 ){
+      addresses.push_back( (static_cast< Address >( 1 ) << bits) - 1 );
+      addresses.push_back(  static_cast< Address >( 1 ) << bits );
+    }
+    std :: mt19937 random( 28 );
+    for( int i = 0 ; i < 100000 ; ++ i )
+      addresses.push_back( static_cast< Address >( random() ) >> (random() % 32) );
+
+    const Serialized data( static_cast< Data >( 0.5f ) );
+
+    std :: size_t bad_size = 0, bad_value = 0, bad_truncated = 0, bad_followed = 0;
+
+    for( const Address address : addresses ){
+
+      Serialized :: value_type frame[ Serialized_Short :: MAX_SIZE + Serialized :: SIZE ];
+      const std :: size_t size = Serialized_Short :: encode( address, frame );
+      bad_size += size != Serialized_Short :: size( address ) || size == 0 || size > Serialized_Short :: MAX_SIZE;
+
+      Address decoded = ~ address;
+      bad_value     += Serialized_Short :: decode( frame, size,     decoded ) != size || decoded != address;
+      bad_truncated += Serialized_Short :: decode( frame, size - 1, decoded ) != 0;
+
+      for( std :: size_t i = 0 ; i < Serialized :: SIZE ; ++ i )
+        frame[ size + i ] = data[ i ];
+      decoded       = ~ address;
+      bad_followed += Serialized_Short :: decode( frame, size + Serialized :: SIZE, decoded ) != size || decoded != address;
+    }
+
+    check( bad_size      == 0, "short size",                         static_cast< long long >( bad_size      ) );
+    check( bad_value     == 0, "short Address",                      static_cast< long long >( bad_value     ) );
+    check( bad_truncated == 0, "short truncated",                    static_cast< long long >( bad_truncated ) );
+    check( bad_followed  == 0, "short Address followed by Data",     static_cast< long long >( bad_followed  ) );
+
+    Address decoded;
+    const Serialized :: value_type continued[] = { 0xC1, 0x01, 0x00 };
+    check( Serialized_Short :: decode( continued, sizeof( continued ), decoded ) == 0, "short continued by Data octet" );
+
+    // short link stream with running status, parsed in random splits
+    std :: vector< Message > messages = random_messages( random, 5000, 200 );
+    for( std :: size_t i = 0 ; i < messages.size() ; i += 7 )
+      messages[ i ].address = static_cast< Address >( random() );
+
+    Octets stream;
+    for( std :: size_t i = 0 ; i < messages.size() ; ++ i ){
+      if( i == 0 || messages[ i ].address != messages[ i - 1 ].address ){
+        Serialized :: value_type frame[ Serialized_Short :: MAX_SIZE ];
+        stream.insert( stream.end(), frame, frame + Serialized_Short :: encode( messages[ i ].address, frame ) );
+      }
+      append( stream, Serialized( messages[ i ].data ) );
+    }
+
+    Serialized_ShortParser   parser;
+    std :: vector< Message > parsed;
+    for( std :: size_t position = 0 ; position < stream.size() ; ){
+      Message             output[ 8 ];
+      std :: size_t       count  = 0;
+      const std :: size_t length = std :: min< std :: size_t >( stream.size() - position, 1 + random() % 40 );
+      position += parser.parse( stream.data() + position, length, output, 1 + random() % 8, count );
+      parsed.insert( parsed.end(), output, output + count );
+    }
+    check( same( parsed, messages ) && parser.invalid() == 0, "short parser round trip", static_cast< long long >( parsed.size() ) );
+
+    // interrupted Address frame, too long Address frame and Data frame with padding bits are discarded
+    Octets broken = { 0x85 };
+    append( broken, Serialized( 1.0f ) );
+    broken.push_back( 0xC1 );
+    append( broken, Serialized( 2.0f ) );
+    broken.insert( broken.end(), Serialized_Short :: MAX_SIZE, 0xC0 );
+    append( broken, Serialized( 3.0f ) );
+    broken.push_back( 0x87 );
+    append( broken, Serialized( 4.0f ) );
+    broken.back() |= 0x70;
+    broken.push_back( 0x86 );
+    append( broken, Serialized( 5.0f ) );
+
+    Serialized_ShortParser   discard;
+    std :: vector< Message > kept;
+    Message                  message;
+    for( const Serialized :: value_type octet : broken )
+      if( discard.parse( octet, message ) )
+        kept.push_back( message );
+    check( same( kept, { Message{ 5, 1.0f }, Message{ 6, 5.0f } } ) && discard.invalid() == 3, "short parser discards broken frames", static_cast< long long >( discard.invalid() ) );
+  }
+
+
+
+  /**
+   * @brief Serialized_RunningStatus and Serialized_Parser round trip, ignored kinds and octet loss
+   */
+  void test_parser( void ){
+
+    std :: mt19937 random( 29 );
+
+    const std :: vector< Message > messages = random_messages( random, 100000, 4 );
+
+    Serialized_RunningStatus sender( 8 );
+    Octets                   stream;
+    for( const Message& message : messages ){
+      Serialized :: value_type frames[ Serialized_RunningStatus :: MAX_SIZE ];
+      stream.insert( stream.end(), frames, frames + sender.encode( message, frames ) );
+    }
+    check( stream.size() < messages.size() * Serialized :: SIZE * 2, "parser running status omits Address" );
+    check( same( parse( stream ), messages ),                         "parser running status round trip" );
+
+    const Message    first { 1, 0.25f };
+    const Message    second{ 2, 0.5f  };
+    const Serialized data( first.data );
+
+    Octets interrupted;
+    append( interrupted, first );
+    const Serialized lost( second.address );
+    interrupted.insert( interrupted.end(), lost.begin(), lost.begin() + 3 );
+    append( interrupted, data );
+    append( interrupted, data );
+    append( interrupted, first );
+    const std :: vector< Message > recovered = parse( interrupted );
+    check( recovered.size() == 2 && recovered[ 0 ].address == 1 && recovered[ 1 ].address == 1,
+           "parser forgets Address after interrupted Address frame", static_cast< long long >( recovered.size() ) );
+
+    Octets ignored;
+    append( ignored, first );
+    const Serialized :: value_type kinds[] = { Serialized :: KIND_CHECK, Serialized :: KIND_SYNC, Serialized :: KIND_CREDIT };
+    for( const Serialized :: value_type kind : kinds ){
+      Serialized frame;
+      frame.encode( static_cast< Address >( 99 ), kind );
+      append( ignored, frame );
+      append( ignored, data );
+    }
+    check( same( parse( ignored ), std :: vector< Message >( 4, first ) ), "parser keeps Address over ignored kinds" );
+
+    // known kinds are skipped without invalid count, Address class frame of unknown kind is invalid
+    const Serialized :: value_type skipped[] = { Serialized :: KIND_BULK, Serialized :: KIND_QUANTIZED_14, Serialized :: KIND_QUANTIZED_21, Serialized :: KIND_DATA };
+    Serialized_Parser counter;
+    for( const Serialized :: value_type kind : skipped ){
+      Serialized frame;
+      frame.encode( static_cast< Address >( 99 ), kind );
+      Message message;
+      for( std :: size_t i = 0 ; i < Serialized :: SIZE ; ++ i )
+        counter.parse( frame[ i ], message );
+    }
+    check( counter.invalid() == 1, "parser counts unknown kind only", static_cast< long long >( counter.invalid() ) );
+
+    Octets unique;
+    std :: vector< Message > originals = random_messages( random, 20000, 1 );
+    for( std :: size_t i = 0 ; i < originals.size() ; ++ i ){
+      originals[ i ].address = static_cast< Address >( i );
+      append( unique, originals[ i ] );
+    }
+
+    Octets damaged;
+    for( const Serialized :: value_type octet : unique )
+      if( random() % 64 != 0 )
+        damaged.push_back( octet );
+
+    const std :: vector< Message > decoded = parse( damaged );
+    std :: size_t wrong = 0;
+    for( const Message& message : decoded )
+      wrong += message.address >= originals.size() || ! same( message.data, originals[ message.address ].data );
+    check( wrong == 0,                                  "parser octet loss never pairs wrong Data", static_cast< long long >( wrong ) );
+    check( decoded.size() > originals.size() * 3 / 4, "parser octet loss keeps intact messages",  static_cast< long long >( decoded.size() ) );
+  }
+
+
+
+  /**
+   * @brief Serialized_PrioritySender share of lanes and preemption by deadline
+   */
+  void test_priority( void ){
+
+    using Sender = Serialized_PrioritySender;
+
+    constexpr Address BULK = 1000; ///< Addresses of bulk lane start from this
+
+    const Sender :: time_point now = Sender :: clock :: now();
+
+    Sender sender( 0.25, std :: chrono :: milliseconds( 2 ) );
+
+    const auto pull = [ & ]( const std :: size_t count, const Sender :: time_point time ){
+      Octets output( count * Sender :: MESSAGE_SIZE );
+      output.resize( sender.pull( output.data(), output.size(), time ) );
+      return parse( output );
+    };
+    const auto bulk_count = [ & ]( const std :: vector< Message >& messages ){
+      std :: size_t result = 0;
+      for( const Message& message : messages )
+        result += message.address >= BULK;
+      return result;
+    };
+
+    for( Address i = 0 ; i < 400 ; ++ i ){
+      sender.push_realtime( Message{ i,        0.0f } );
+      sender.push_bulk    ( Message{ BULK + i, 0.0f } );
+    }
+    const std :: size_t shared = bulk_count( pull( 100, now + std :: chrono :: seconds( 1 ) ) );
+    check( shared >= 24 && shared <= 26, "priority bulk share without deadline", static_cast< long long >( shared ) );
+
+    for( Address i = 0 ; i < 50 ; ++ i )
+      sender.push_realtime( Message{ 500 + i, 0.0f }, now + std :: chrono :: milliseconds( 1 ) );
+    const std :: vector< Message > urgent = pull( 50, now );
+    check( bulk_count( urgent ) == 0 && urgent.front().address == 500, "priority deadline in slack preempts bulk" );
+
+    const std :: size_t after = bulk_count( pull( 100, now ) );
+    check( after >= 24 && after <= 26, "priority preemption doesn't grow bulk balance", static_cast< long long >( after ) );
+
+    sender.push_realtime( Message{ 600, 0.0f }, now - std :: chrono :: milliseconds( 1 ) );
+    pull( 1, now );
+    check( sender.missed() == 1, "priority missed deadline", static_cast< long long >( sender.missed() ) );
+  }
+
+
+
+  /**
+   * @brief Serialized_ParallelDecoder gives same messages as one Serialized_Parser
+   *
+   * Stream mixes running status, integrity, version marker and credit frames between Data frames,
+   * bulk frames and lost octets, and is decoded with many small chunks.
+   */
+  void test_parallel( void ){
+
+    std :: mt19937 random( 32 );
+
+    Octets                   stream;
+    Serialized_RunningStatus sender( 64 );
+
+    for( int i = 0 ; i < 200000 ; ++ i ){
+
+      const std :: uint32_t choice = random() % 100;
+
+      if( choice < 85 ){
+        Serialized :: value_type frames[ Serialized_RunningStatus :: MAX_SIZE ];
+        const Message message{ static_cast< Address >( random() % 3 ), random_data( random ) };
+        stream.insert( stream.end(), frames, frames + sender.encode( message, frames ) );
+      }
+      else if( choice < 95 ){
+        const Serialized :: value_type kinds[] = { Serialized :: KIND_CHECK, Serialized :: KIND_SYNC, Serialized :: KIND_CREDIT };
+        Serialized frame;
+        frame.encode( static_cast< Address >( random() ), kinds[ random() % 3 ] );
+        append( stream, frame );
+      }
+      else if( choice < 97 ){
+        Data   array[ 8 ];
+        Octets frame( Serialized_Bulk :: size( 8 ) );
+        for( Data& data : array )
+          data = random_data( random );
+        frame.resize( Serialized_Bulk :: encode( static_cast< Address >( random() ), array, 8, frame.data() ) );
+        stream.insert( stream.end(), frame.begin(), frame.end() );
+        sender.reset();
+      }
+      else if( ! stream.empty() )
+        stream.pop_back();
+    }
+
+    const std :: vector< Message > serial = parse( stream );
+
+    const std :: size_t chunks[] = { 10, 64, 1000, 1 << 20 };
+    for( const std :: size_t chunk : chunks ){
+      Serialized_ParallelDecoder decoder( 4, chunk );
+      std :: vector< Message >   parallel;
+      decoder.decode( stream.data(), stream.size(), parallel );
+      check( same( parallel, serial ), "parallel same as one parser", static_cast< long long >( chunk ) );
+    }
+  }
+
+
+
+  /**
+   * @brief Pool reuses objects parked in cache of other thread, and Arena bump allocation
+   */
+  void test_pool( void ){
+
+    Pool< Message, 32 > pool( 8 );
+
+    std :: mutex              mutex;
+    std :: condition_variable condition;
+    bool                      parked = false;
+    bool                      done   = false;
+
+    std :: thread other( [ & ]{
+        std :: vector< Message* > items;
+        for( int i = 0 ; i < 8 ; ++ i )
+          items.push_back( pool.acquire( Message{ static_cast< Address >( i ), 0.0f } ) );
+        for( Message* item : items )
+          pool.release( item );
+
+        std :: unique_lock< std :: mutex > lock( mutex );
+        parked = true;
+        condition.notify_all();
+        condition.wait( lock, [ & ]{ return done; } );
+      } );
+
+    {
+      std :: unique_lock< std :: mutex > lock( mutex );
+      condition.wait( lock, [ & ]{ return parked; } );
+    }
+
+    std :: vector< Message* > items;
+    for( int i = 0 ; i < 8 ; ++ i )
+      items.push_back( pool.acquire() );
+    check( std :: find( items.begin(), items.end(), nullptr ) == items.end(), "pool takes objects cached by other thread" );
+    check( pool.acquire() == nullptr,                                       "pool exhausted at capacity" );
+    for( Message* item : items )
+      pool.release( item );
+
+    {
+      std :: lock_guard< std :: mutex > lock( mutex );
+      done = true;
+    }
+    condition.notify_all();
+    other.join();
+
+    const PoolStatistics statistics = pool.statistics();
+    check( statistics.allocated == 16 && statistics.released == 16 && statistics.failed == 1 && statistics.peak == 8, "pool statistics" );
+
+    Arena arena( 1024 );
+    std :: uint32_t* first  = arena.allocate_array< std :: uint32_t >( 100 );
+    double*          second = arena.allocate_array< double >( 10 );
+    check( first != nullptr && second != nullptr && reinterpret_cast< std :: uintptr_t >( second ) % alignof( double ) == 0, "arena allocates aligned" );
+    check( arena.allocate( 1024 ) == nullptr,                                                                         "arena exhausted" );
+    arena.reset();
+    check( arena.used() == 0 && arena.allocate( 1024 ) != nullptr,                                                   "arena reset" );
+  }
+
+
+
+  /**
+   * @brief bitwise CRC32C as reference of Crc32c
+   */
+  std :: uint32_t reference_crc( const Serialized :: value_type* input, const std :: size_t length ){
+    std :: uint32_t crc = 0xFFFFFFFF;
+    for( std :: size_t i = 0 ; i < length ; ++ i ){
+      crc ^= input[ i ];
+      for( int bit = 0 ; bit < 8 ; ++ bit )
+        crc = (crc >> 1) ^ (0x82F63B78 & (0 - (crc & 1)));
+    }
+    return ~ crc;
+  }
+
+  /**
+   * @brief Crc32c against bitwise reference, and Serialized_IntegrityChecker with split input and corrupted octets
+   */
+  void test_integrity( void ){
+
+    std :: mt19937 random( 36 );
+
+    Octets buffer( 4096 );
+    for( Serialized :: value_type& octet : buffer )
+      octet = static_cast< Serialized :: value_type >( random() );
+
+    std :: size_t wrong = 0;
+    for( int i = 0 ; i < 2000 ; ++ i ){
+      const std :: size_t offset = random() % 64;
+      const std :: size_t length = random() % (buffer.size() - offset);
+      wrong += Crc32c :: compute( buffer.data() + offset, length ) != reference_crc( buffer.data() + offset, length );
+    }
+    check( wrong == 0, "integrity CRC32C against bitwise reference", static_cast< long long >( wrong ) );
+    check( Crc32c :: compute( reinterpret_cast< const Serialized :: value_type* >( "123456789" ), 9 ) == 0xE3069283, "integrity CRC32C check value" );
+
+    Serialized_IntegritySender     sender( 16 );
+    Octets                         stream;
+    std :: vector< bool >          protect; ///< true for octets of integrity frames
+    const std :: vector< Message > messages = random_messages( random, 50000, 100 );
+    std :: size_t                  frames   = 0;
+
+    for( const Message& message : messages ){
+      const std :: size_t start = stream.size();
+      append( stream, message );
+      protect.resize( stream.size(), false );
+      if( sender.update( stream.data() + start, stream.size() - start ) ){
+        Serialized frame;
+        sender.encode( frame );
+        append( stream, frame );
+        protect.resize( stream.size(), true );
+        ++ frames;
+      }
+    }
+
+    check( same( parse( stream ), messages ), "integrity frames ignored by parser" );
+
+    Serialized_IntegrityChecker whole;
+    check( whole.verify( stream.data(), stream.size() ) == 0 && whole.blocks() == frames, "integrity whole stream", whole.blocks() );
+
+    std :: size_t bad_split = 0;
+    for( int trial = 0 ; trial < 20 ; ++ trial ){
+      Serialized_IntegrityChecker checker;
+      for( std :: size_t offset = 0 ; offset < stream.size() ; ){
+        const std :: size_t size = std :: min( stream.size() - offset, static_cast< std :: size_t >( random() % (trial < 10 ? 8 : 300) + 1 ) );
+        checker.verify( stream.data() + offset, size );
+        offset += size;
+      }
+      bad_split += checker.bad() != 0 || checker.blocks() != frames;
+    }
+    check( bad_split == 0, "integrity split at any position", static_cast< long long >( bad_split ) );
+
+    std :: size_t missed = 0, misplaced = 0;
+    for( int trial = 0 ; trial < 500 ; ++ trial ){
+
+      std :: size_t position;
+      do
+        position = random() % stream.size();
+      while( protect[ position ] );
+
+      Octets corrupted = stream;
+      corrupted[ position ] ^= static_cast< Serialized :: value_type >( random() % 0x7F + 1 );
+
+      Serialized_IntegrityChecker :: Block report[ 4 ];
+      Serialized_IntegrityChecker          checker;
+      std :: size_t                        found = 0;
+      for( std :: size_t offset = 0 ; offset < corrupted.size() ; ){
+        const std :: size_t size = std :: min( corrupted.size() - offset, static_cast< std :: size_t >( random() % 100 + 1 ) );
+        found  += checker.verify( corrupted.data() + offset, size, report + std :: min< std :: size_t >( found, 4 ), 4 - std :: min< std :: size_t >( found, 4 ) );
+        offset += size;
+      }
+
+      const bool last_block = std :: find( protect.begin() + position, protect.end(), true ) == protect.end();
+      if( last_block )
+        continue;
+
+      // a corrupted last octet of Address frame may look like integrity frame, then 2 blocks are bad
+      missed    += found == 0;
+      misplaced += found == 1 && ! ( report[ 0 ].offset <= position && position < report[ 0 ].offset + report[ 0 ].length );
+    }
+    check( missed    == 0, "integrity corrupted octet detected",     static_cast< long long >( missed    ) );
+    check( misplaced == 0, "integrity bad block covers the octet",   static_cast< long long >( misplaced ) );
+  }
+
+
+
+  /**
+   * @brief ParameterStore snapshot and diff applied by Serialized_StateReceiver in random splits
+   */
+  void test_state( void ){
+
+    std :: mt19937 random( 37 );
+
+    ParameterStore store;
+    for( Address address = 0 ; address < 20000 ; ++ address )
+      if( random() % 8 != 0 )
+        store.set( address, random_data( random ) );
+
+    std :: vector< Message > received;
+    Serialized_StateReceiver receiver( [ & ]( const Message* messages, const std :: size_t count ){
+      received.insert( received.end(), messages, messages + count );
+    } );
+
+    const auto apply = [ & ]( const Octets& octets ){
+      std :: size_t position = 0;
+      while( position < octets.size() ){
+        const std :: size_t size = std :: min( octets.size() - position, static_cast< std :: size_t >( random() % 700 + 1 ) );
+        receiver.apply( octets.data() + position, size );
+        position += size;
+      }
+    };
+    const auto matches = [ & ]( void ){
+      bool result = true;
+      for( const Message& message : received ){
+        Data data;
+        result = result && store.get( message.address, data ) && same( data, message.data );
+      }
+      return result;
+    };
+
+    Octets snapshot;
+    const std :: uint32_t version = store.snapshot( snapshot );
+    apply( snapshot );
+    check( received.size() == store.size(),  "state snapshot count",   static_cast< long long >( received.size() ) );
+    check( matches(),                        "state snapshot data" );
+    check( receiver.synced() && receiver.version() == version, "state snapshot version", receiver.version() );
+
+    for( std :: size_t round = 0 ; round < 20 ; ++ round ){
+
+      const std :: uint32_t since = receiver.version();
+      const std :: size_t   count = random() % 500;
+      for( std :: size_t i = 0 ; i < count ; ++ i )
+        store.set( random() % 21000, random_data( random ) );
+
+      Octets diff, again;
+      store.diff( since, diff );
+      store.diff( since, again );
+      check( diff == again, "state diff repeatable", static_cast< long long >( round ) );
+
+      received.clear();
+      apply( diff );
+      check( received.size() <= count && matches(), "state diff data",    static_cast< long long >( round ) );
+      check( receiver.version() == store.version(), "state diff version", static_cast< long long >( round ) );
+    }
+
+    check( receiver.invalid() == 0, "state no invalid frames", static_cast< long long >( receiver.invalid() ) );
+  }
+
+
+
+  /**
+   * @brief Serialized_Router passes each message to outputs of its Address in random splits,
+   *        and drops Data after an interrupted Address frame
+   */
+  void test_router( void ){
+
+    std :: mt19937 random( 38 );
+
+    Serialized_Router       router;
+    std :: vector< Octets > outputs( 3 );
+    for( Octets& output : outputs )
+      router.add_output( [ &output ]( const Serialized_Router :: Slice& slice ){
+        output.insert( output.end(), slice.prefix, slice.prefix + slice.prefix_size );
+        output.insert( output.end(), slice.begin(), slice.end() );
+      } );
+    router.add_rule(   0,  99, 0 );
+    router.add_rule( 100, 199, 1 );
+    router.add_rule(  50, 149, 2 );
+
+    const auto route = [ & ]( const Octets& stream ){
+      std :: size_t position = 0;
+      while( position < stream.size() ){
+        const std :: size_t size = std :: min( stream.size() - position, static_cast< std :: size_t >( random() % 40 + 1 ) );
+        router.route( std :: make_shared< const Serialized_Router :: Buffer >( stream.begin() + position, stream.begin() + position + size ) );
+        position += size;
+      }
+    };
+
+    const std :: vector< Message > messages = random_messages( random, 20000, 250 );
+    Octets stream;
+    for( const Message& message : messages )
+      append( stream, message );
+    route( stream );
+
+    const Address lows [] = {   0, 100,  50 };
+    const Address highs[] = {  99, 199, 149 };
+    for( std :: size_t output = 0 ; output < outputs.size() ; ++ output ){
+      std :: vector< Message > expected;
+      for( const Message& message : messages )
+        if( lows[ output ] <= message.address && message.address <= highs[ output ] )
+          expected.push_back( message );
+      check( same( parse( outputs[ output ] ), expected ), "router output messages", static_cast< long long >( output ) );
+    }
+
+    for( Octets& output : outputs )
+      output.clear();
+
+    const Message first { 120, 1.0f };
+    const Message broken{  20, 2.0f };
+    Octets        truncated;
+    append( truncated, first );
+    append( truncated, Serialized( broken.address ) );
+    truncated.resize( truncated.size() - 2 );
+    append( truncated, Serialized( broken.data ) );
+    append( truncated, first );
+
+    const std :: uint64_t invalid = router.invalid();
+    route( truncated );
+
+    check( router.invalid() == invalid + 1,                "router interrupted Address counted",             static_cast< long long >( router.invalid() - invalid ) );
+    check( outputs[ 0 ].empty(),                           "router interrupted Address not routed",          static_cast< long long >( outputs[ 0 ].size() ) );
+    check( outputs[ 1 ].size() == Serialized :: SIZE * 4, "router no stale Data after interrupted Address", static_cast< long long >( outputs[ 1 ].size() ) );
+    check( same( parse( outputs[ 1 ] ), { first, first } ), "router output after interrupted Address",        static_cast< long long >( outputs[ 1 ].size() ) );
+  }
+
+
+
+  /**
+   * @brief SubscriptionIndex single and batch match() give same subscribers as a linear scan of subscriptions
+   */
+  void test_subscription( void ){
+
+    std :: mt19937 random( 39 );
+
+    struct Pattern {
+      SubscriptionIndex :: Subscriber subscriber; ///< subscriber id
+      Address                         low;        ///< first Address
+      Address                         high;       ///< last Address
+    };
+
+    SubscriptionIndex       index;
+    std :: vector< Pattern > patterns;
+    std :: vector< Address > addresses;
+
+    for( std :: size_t i = 0 ; i < 3000 ; ++ i ){
+      const SubscriptionIndex :: Subscriber subscriber = random() % 500 * 7;
+      if( random() % 4 == 0 ){
+        const unsigned int bits   = random() % 33;
+        const Address      prefix = random();
+        const Address      rest   = bits == 0 ? ~static_cast< Address >( 0 ) : static_cast< Address >( (static_cast< std :: uint64_t >( 1 ) << (32 - bits)) - 1 );
+        index.subscribe_prefix( subscriber, prefix, bits );
+        patterns.push_back( Pattern{ subscriber, static_cast< Address >( prefix & ~rest ), static_cast< Address >( prefix | rest ) } );
+      }
+      else {
+        const Address low  = random() % 100000;
+        const Address high = random() % 8 == 0 ? ~static_cast< Address >( 0 ) : low + random() % 2000;
+        index.subscribe( subscriber, low, high );
+        patterns.push_back( Pattern{ subscriber, low, high } );
+      }
+      addresses.push_back( patterns.back().low );
+      addresses.push_back( patterns.back().high );
+      addresses.push_back( patterns.back().high + 1 );
+    }
+    for( std :: size_t i = 0 ; i < 20000 ; ++ i )
+      addresses.push_back( random() % 4 == 0 ? static_cast< Address >( random() ) : static_cast< Address >( random() % 110000 ) );
+
+    const auto verify = [ & ]( const char* what ){
+
+      std :: vector< SubscriptionIndex :: Set > sets( addresses.size() );
+      index.match( addresses.data(), addresses.size(), sets.data() );
+
+      std :: size_t wrong = 0;
+      for( std :: size_t i = 0 ; i < addresses.size() ; ++ i ){
+
+        std :: vector< SubscriptionIndex :: Subscriber > expected;
+        for( const Pattern& pattern : patterns )
+          if( pattern.low <= addresses[ i ] && addresses[ i ] <= pattern.high )
+            expected.push_back( pattern.subscriber );
+        std :: sort( expected.begin(), expected.end() );
+        expected.erase( std :: unique( expected.begin(), expected.end() ), expected.end() );
+
+        const SubscriptionIndex :: Set single = index.match( addresses[ i ] );
+        if( ! std :: equal( expected.begin(), expected.end(), single.begin(), single.end() )
+            || ! std :: equal( expected.begin(), expected.end(), sets[ i ].begin(), sets[ i ].end() ) )
+          ++ wrong;
+      }
+      check( wrong == 0, what, static_cast< long long >( wrong ) );
+    };
+
+    check( index.match( 0 ).empty(), "subscription empty before build" );
+    check( index.dirty(),            "subscription dirty before build" );
+    index.build();
+    verify( "subscription same as linear scan" );
+
+    for( std :: size_t i = 0 ; i < 100 ; ++ i ){
+      const SubscriptionIndex :: Subscriber subscriber = random() % 500 * 7;
+      index.unsubscribe( subscriber );
+      patterns.erase( std :: remove_if( patterns.begin(), patterns.end(), [ subscriber ]( const Pattern& pattern ){ return pattern.subscriber == subscriber; } ), patterns.end() );
+    }
+    index.build();
+    verify( "subscription same as linear scan after unsubscribe" );
+  }
+
+
+
+  /**
+   * @brief ParameterSmoother applies changes scheduled in any order at their offsets, and drops changes over capacity
+   */
+  void test_smoother( void ){
+
+    std :: mt19937 random( 40 );
+
+    constexpr std :: size_t COUNT  = 8;
+    constexpr std :: size_t FRAMES = 64;
+
+    ParameterSmoother smoother( COUNT, 48000, 100, 32 );
+
+    std :: vector< std :: vector< float > > buffers( COUNT, std :: vector< float >( FRAMES ) );
+    float*                                  outputs[ COUNT ];
+    for( std :: size_t index = 0 ; index < COUNT ; ++ index )
+      outputs[ index ] = buffers[ index ].data();
+
+    std :: size_t wrong = 0;
+
+    for( std :: size_t block = 0 ; block < 200 ; ++ block ){
+
+      // expected output of STEP mode, later schedule wins at same offset
+      std :: vector< std :: vector< float > > expected( COUNT );
+      for( std :: size_t index = 0 ; index < COUNT ; ++ index )
+        expected[ index ].assign( FRAMES, smoother.value( index ) );
+
+      std :: vector< std :: vector< std :: pair< std :: size_t, float > > > changes( COUNT );
+      const std :: size_t count = random() % 32 + 1;
+      for( std :: size_t i = 0 ; i < count ; ++ i ){
+        const std :: size_t   index  = random() % COUNT;
+        const std :: uint32_t offset = random() % (FRAMES + 8);
+        const float           target = static_cast< float >( random() % 1000 );
+        smoother.schedule( Message{ static_cast< Address >( 100 + index ), target }, offset );
+        changes[ index ].emplace_back( std :: min< std :: size_t >( offset, FRAMES ), target );
+      }
+      for( std :: size_t index = 0 ; index < COUNT ; ++ index ){
+        std :: stable_sort( changes[ index ].begin(), changes[ index ].end()
+          , []( const std :: pair< std :: size_t, float >& lhs, const std :: pair< std :: size_t, float >& rhs ){ return lhs.first < rhs.first; } );
+        for( const std :: pair< std :: size_t, float >& change : changes[ index ] )
+          std :: fill( expected[ index ].begin() + change.first, expected[ index ].end(), change.second );
+      }
+
+      smoother.render( outputs, FRAMES );
+
+      for( std :: size_t index = 0 ; index < COUNT ; ++ index )
+        if( buffers[ index ] != expected[ index ] )
+          ++ wrong;
+    }
+    check( wrong == 0, "smoother changes at offsets", static_cast< long long >( wrong ) );
+
+    std :: size_t accepted = 0;
+    for( std :: size_t i = 0 ; i < 40 ; ++ i )
+      accepted += smoother.schedule( i % COUNT, 1.0f, static_cast< std :: uint32_t >( i ) ) ? 1 : 0;
+    check( accepted == smoother.capacity(), "smoother capacity",      static_cast< long long >( accepted ) );
+    check( smoother.dropped() == 8,         "smoother dropped count", static_cast< long long >( smoother.dropped() ) );
+
+    smoother.render( outputs, FRAMES );
+    check( smoother.schedule( 0, 2.0f ),    "smoother schedules after render" );
+  }
+
+
+
+  /**
+   * @brief last Data passed to schema handlers
+   */
+  Data schema_gain   = 0;
+  Data schema_cutoff = 0;
+
+  void on_gain  ( const Data data ){ schema_gain   = data; }
+  void on_cutoff( const Data data ){ schema_cutoff = data; }
+
+  /**
+   * @brief definition of a schema
+   */
+  struct Synth {
+    constexpr static Schema :: Parameter parameters[] = {
+        { 0x10, Schema :: Payload :: DATA,         0,     1, &on_gain   }
+      , { 0x12, Schema :: Payload :: QUANTIZED_14, 20, 20000, &on_cutoff }
+    };
+  };
+  constexpr Schema :: Parameter Synth :: parameters[];
+
+  /**
+   * @brief Schema :: Dispatcher clamps Data to the range of parameters, and encodes Address frames with kinds of payloads
+   */
+  void test_schema( void ){
+
+    using SynthSchema = Schema :: Dispatcher< Synth >;
+
+    static_assert( SynthSchema :: size() == 2 && SynthSchema :: SPAN == 3, "schema table" );
+
+    check( SynthSchema :: dispatch( Message{ 0x10, 0.5f } ) && schema_gain == 0.5f,    "schema dispatch" );
+    check( SynthSchema :: dispatch( 0x10, 2.0f )            && schema_gain == 1.0f,    "schema clamp maximum" );
+    check( SynthSchema :: dispatch( 0x12, 1.0f )            && schema_cutoff == 20.0f, "schema clamp minimum" );
+    check( ! SynthSchema :: dispatch( 0x11, 1.0f ) && ! SynthSchema :: dispatch( 0x0F, 1.0f ) && ! SynthSchema :: dispatch( 0x13, 1.0f ), "schema unknown Address" );
+
+    Serialized expected;
+    expected.encode( 0x12, Serialized :: KIND_QUANTIZED_14 );
+    const SynthSchema :: Frame& frame = SynthSchema :: frame< 0x12 >();
+    check( std :: equal( frame.begin(), frame.end(), &expected[ 0 ] ), "schema Address frame" );
+    check( SynthSchema :: frame( 0x11 ) == nullptr,                       "schema no frame of unknown Address" );
+  }
+
+
+
+  /**
+   * @brief SharedTable reader sees writer's Data, tables are not recreated with other size, closed tables are safe to query
+   */
+  void test_shared( void ){
+
+    char name[ 32 ];
+    std :: snprintf( name, sizeof( name ), "/sc_test_%ld", static_cast< long >( getpid() ) );
+    SharedTable :: remove( name );
+
+    SharedTable writer, reader, closed;
+    Data        data = 0;
+
+    check( closed.first() == 0 && closed.size() == 0 && closed.changes() == 0, "shared closed accessors" );
+    check( ! closed.read( 0, data ) && ! closed.write( 0, 1.0f ),              "shared closed read and write" );
+    check( ! reader.open( name ),                                              "shared open missing table" );
+
+    check( writer.create( name, 100, 64 ),                                      "shared create" );
+    check( writer.write( 110, 3.5f, 7 ) && ! writer.write( 164, 1.0f ),         "shared write" );
+    check( reader.open( name ) && reader.first() == 100 && reader.size() == 64, "shared open" );
+
+    std :: uint64_t time = 0;
+    check( reader.read( 110, data, &time ) && data == 3.5f && time == 7, "shared read" );
+    check( ! reader.write( 110, 1.0f ),                                  "shared reader can't write" );
+
+    SharedTable other;
+    check( ! other.create( name, 100, 128 ) && ! other.is_open(),             "shared refuse other size" );
+    check( ! other.create( name, 200, 64 )  && ! other.is_open(),             "shared refuse other Addresses" );
+    check( other.create( name, 100, 64 ) && other.write( 111, 4.5f ),         "shared open again as writer" );
+    check( reader.read( 110, data ) && data == 3.5f,                          "shared slots kept" );
+    check( reader.read( 111, data ) && data == 4.5f && reader.changes() == 2, "shared second writer visible" );
+
+    // writer died between sequence stores of slot 112, header is 64 octets and slot is 16 octets from sequence
+    {
+      const int fd     = shm_open( name, O_RDWR, 0 );
+      void*     memory = mmap( nullptr, 64 + 16 * 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+      close( fd );
+      std :: atomic< std :: uint32_t >* sequence = reinterpret_cast< std :: atomic< std :: uint32_t >* >( static_cast< char* >( memory ) + 64 + 16 * 12 );
+
+      sequence -> store( 3 );
+      check( ! reader.read( 112, data ), "shared read gives up on crashed write" );
+
+      other.close();
+      check( other.create( name, 100, 64 ) && sequence -> load() == 4,               "shared restart makes sequence even", static_cast< long long >( sequence -> load() ) );
+      check( other.write( 112, 5.5f ) && sequence -> load() == 6,                    "shared restarted write keeps parity", static_cast< long long >( sequence -> load() ) );
+      check( reader.read( 112, data ) && data == 5.5f && reader.read( 110, data ) && data == 3.5f, "shared read after restart" );
+      munmap( memory, 64 + 16 * 64 );
+    }
+
+    check( SharedTable :: remove( name ), "shared remove" );
+  }
+
+
+
+  /**
+   * @brief BlockEvents delivers events published after a future event in their blocks, and merges over capacity
+   */
+  void test_events( void ){
+
+    std :: mt19937 random( 44 );
+
+    constexpr std :: uint64_t FRAMES = 64;
+
+    {
+      BlockEvents events( 16 );
+      events.push( Message{ 1, 1.0f }, 10000 );
+      events.publish();
+      check( events.acquire( 0, FRAMES ).empty(), "events future event kept" );
+
+      events.push( Message{ 2, 2.0f }, 100 );
+      events.push( Message{ 3, 3.0f }, 10 );
+      check( events.publish(), "events publish after future event" );
+
+      const BlockEvents :: Span span = events.acquire( FRAMES, FRAMES );
+      check( span.size == 2 && span.data[ 0 ].address == 3 && span.data[ 0 ].offset == 0
+                            && span.data[ 1 ].address == 2 && span.data[ 1 ].offset == 100 - FRAMES, "events late earlier events", static_cast< long long >( span.size ) );
+      check( events.acquire( 10000, FRAMES ).size == 1,                                             "events future event after merge" );
+    }
+
+    {
+      BlockEvents events( 4 );
+      for( std :: uint64_t time = 1000 ; time < 1003 ; ++ time )
+        events.push( Message{ 1, 1.0f }, time );
+      events.publish();
+      events.acquire( 0, FRAMES );
+      for( std :: uint64_t time = 100 ; time < 103 ; ++ time )
+        events.push( Message{ 2, 2.0f }, time );
+      events.publish();
+
+      const BlockEvents :: Span span = events.acquire( 0, 2000 );
+      check( span.size == 4 && span.data[ 2 ].time == 102 && span.data[ 3 ].time == 1000, "events merge keeps earliest", static_cast< long long >( span.size ) );
+      check( events.overflow() == 2,                                                       "events merge overflow",      static_cast< long long >( events.overflow() ) );
+    }
+
+    // random times, each event is delivered once, in the block of its time or the first block after its publish
+    BlockEvents                      events( 256 );
+    std :: vector< std :: uint64_t > published;   ///< block of publish of each event, by Address
+    std :: vector< std :: uint64_t > times;       ///< time of each event, by Address
+    std :: vector< std :: size_t >   delivered;   ///< number of deliveries of each event, by Address
+    std :: size_t                    pending = 0; ///< events pushed but not published
+    std :: size_t                    late    = 0;
+    std :: size_t                    order   = 0;
+
+    for( std :: uint64_t block = 0 ; block < 3000 ; ++ block ){
+
+      const std :: uint64_t start = block * FRAMES;
+
+      for( std :: size_t i = random() % 8 ; i != 0 ; -- i ){
+        const std :: uint64_t time = start + FRAMES + random() % (random() % 16 == 0 ? 20000 : 500);
+        if( ! events.push( Message{ static_cast< Address >( times.size() ), 0.0f }, time ) )
+          continue;
+        times    .push_back( time );
+        published.push_back( ~static_cast< std :: uint64_t >( 0 ) );
+        delivered.push_back( 0 );
+        ++ pending;
+      }
+      if( events.publish() ){
+        for( std :: size_t k = published.size() - pending ; k < published.size() ; ++ k )
+          published[ k ] = block;
+        pending = 0;
+      }
+
+      const BlockEvents :: Span span = events.acquire( start, FRAMES );
+      std :: uint64_t           last = 0;
+      for( const BlockEvents :: Event& event : span ){
+        ++ delivered[ event.address ];
+        order += event.time < last || event.offset != (event.time < start ? 0 : event.time - start) ? 1 : 0;
+        last   = event.time;
+      }
+
+      // published before this block and due in it
+      for( std :: size_t k = 0 ; k < times.size() ; ++ k )
+        if( published[ k ] < block && times[ k ] < start + FRAMES && delivered[ k ] == 0 )
+          ++ late;
+    }
+
+    std :: size_t twice = 0;
+    for( const std :: size_t count : delivered )
+      twice += count > 1 ? 1 : 0;
+
+    check( late  == 0,             "events delivered in time",   static_cast< long long >( late ) );
+    check( order == 0,             "events sorted with offsets", static_cast< long long >( order ) );
+    check( twice == 0,             "events delivered once",      static_cast< long long >( twice ) );
+    check( events.overflow() == 0, "events no overflow",         static_cast< long long >( events.overflow() ) );
+  }
+
+
+
+  /**
+   * @brief Serialized_CreditSender never overflows receive buffer of Serialized_CreditReceiver,
+   *        with credit frames split and mixed with returned messages, and coalesces to latest Data
+   */
+  void test_credit( void ){
+
+    std :: mt19937 random( 47 );
+
+    constexpr std :: uint32_t WINDOW = 256;
+
+    Serialized_CreditReceiver receiver( WINDOW );
+    Serialized_CreditSender   sender( 0, false );
+    Serialized_Parser         parser;
+
+    const std :: vector< Message > messages = random_messages( random, 20000, 300 );
+    std :: vector< Message >       received;
+    Octets                         buffer;   ///< receive buffer of receiver
+    Octets                         returned; ///< octets from receiver to sender, not received yet
+    Octets                         link;     ///< all octets from receiver to sender
+    std :: vector< Message >       answers;  ///< messages returned with credit frames
+    std :: size_t                  peak  = 0;
+    std :: size_t                  found = 0;
+
+    Serialized frame;
+    receiver.encode( frame );
+    append( returned, frame );
+
+    for( std :: size_t next = 0, round = 0 ; received.size() < messages.size() && round < 1000000 ; ++ round ){
+
+      for( std :: size_t i = random() % 16 ; i != 0 && next < messages.size() ; -- i )
+        sender.push( messages[ next ++ ] );
+
+      Serialized :: value_type octets[ 100 ];
+      const std :: size_t      length = sender.pull( octets, random() % sizeof( octets ) + 1 );
+      buffer.insert( buffer.end(), octets, octets + length );
+      peak = std :: max( peak, buffer.size() );
+
+      // receiver reads a part of its buffer
+      const std :: size_t read = std :: min< std :: size_t >( buffer.size(), random() % 40 );
+      for( std :: size_t i = 0 ; i < read ; ++ i ){
+        Message message;
+        if( parser.parse( buffer[ i ], message ) )
+          received.push_back( message );
+      }
+      buffer.erase( buffer.begin(), buffer.begin() + read );
+
+      if( receiver.consume( read ) ){
+        receiver.encode( frame );
+        append( returned, frame );
+      }
+      if( random() % 4 == 0 ){
+        const Message answer{ static_cast< Address >( random() % 100 ), random_data( random ) };
+        answers.push_back( answer );
+        append( returned, answer );
+      }
+
+      // returned octets arrive in random pieces
+      const std :: size_t size = std :: min< std :: size_t >( returned.size(), random() % 12 );
+      found += sender.receive( returned.data(), size );
+      link.insert( link.end(), returned.begin(), returned.begin() + size );
+      returned.erase( returned.begin(), returned.begin() + size );
+    }
+    found += sender.receive( returned.data(), returned.size() );
+    link.insert( link.end(), returned.begin(), returned.end() );
+
+    check( same( received, messages ),                       "credit messages in order",              static_cast< long long >( received.size() ) );
+    check( peak <= WINDOW,                                   "credit receive buffer not overflowed",  static_cast< long long >( peak ) );
+    check( found == sender.credits() && found > 0,           "credit frames found",                   static_cast< long long >( found ) );
+    check( same( parse( link ), answers ),                   "credit frames ignored by parser",       static_cast< long long >( answers.size() ) );
+    check( sender.dropped() == 0 && sender.coalesced() == 0, "credit nothing dropped or coalesced" );
+
+    // without credit, queued messages of same Address are coalesced to latest Data
+    Serialized_CreditSender coalescing( 0, true );
+    std :: vector< Data >   latest( 10 );
+    for( std :: size_t i = 0 ; i < 5000 ; ++ i ){
+      const Message message{ static_cast< Address >( random() % 10 ), random_data( random ) };
+      latest[ message.address ] = message.data;
+      coalescing.push( message );
+    }
+    Serialized :: value_type octets[ 200 ];
+    check( coalescing.size() == 10 && coalescing.pull( octets, sizeof( octets ) ) == 0, "credit coalesced without credit", static_cast< long long >( coalescing.size() ) );
+
+    coalescing.credit( 1000 );
+    const std :: size_t            length    = coalescing.pull( octets, sizeof( octets ) );
+    const std :: vector< Message > coalesced = parse( Octets( octets, octets + length ) );
+    bool                           newest    = coalesced.size() == 10;
+    for( const Message& message : coalesced )
+      newest = newest && same( message.data, latest[ message.address ] );
+    check( newest, "credit coalesced to latest Data", static_cast< long long >( coalesced.size() ) );
+  }
+
+
+
+  /**
+   * @brief append a big endian 32 bits word to OSC octets
+   */
+  void append_word( std :: vector< char >& output, const std :: uint32_t word ){
+    for( int shift = 24 ; shift >= 0 ; shift -= 8 )
+      output.push_back( static_cast< char >( (word >> shift) & 0xFF ) );
+  }
+
+  /**
+   * @brief append a padded OSC string
+   */
+  void append_string( std :: vector< char >& output, const char* string ){
+    const std :: size_t length = std :: strlen( string );
+    output.insert( output.end(), string, string + length );
+    output.insert( output.end(), 4 - length % 4, '\0' );
+  }
+
+  /**
+   * @brief OscBridge encode() and decode() round trip, argument types, nested bundles, unknown paths and truncated packets
+   */
+  void test_osc( void ){
+
+    std :: mt19937 random( 48 );
+
+    OscBridge bridge;
+    for( Address i = 0 ; i < 200 ; ++ i ){
+      char path[ 32 ];
+      std :: snprintf( path, sizeof( path ), "/synth/%u/value", static_cast< unsigned int >( i ) );
+      bridge.add( path, i * 4 );
+    }
+
+    std :: vector< Message > messages = random_messages( random, 1000, 200 );
+    for( Message& message : messages )
+      message.address *= 4;
+
+    std :: vector< char >    packet;
+    std :: vector< Message > decoded;
+    std :: size_t            wrong = 0;
+    for( std :: size_t position = 0 ; position < messages.size() ; ){
+      const std :: size_t count = std :: min< std :: size_t >( messages.size() - position, random() % 40 + 1 );
+      wrong += bridge.encode( messages.data() + position, count, packet ) == count ? 0 : 1;
+
+      // decode from an unaligned copy
+      std :: vector< char > unaligned( 1 );
+      unaligned.insert( unaligned.end(), packet.begin(), packet.end() );
+      wrong += bridge.decode( unaligned.data() + 1, packet.size(), decoded ) ? 0 : 1;
+      position += count;
+    }
+    check( wrong == 0,                "osc encode and decode", static_cast< long long >( wrong ) );
+    check( same( decoded, messages ), "osc round trip",        static_cast< long long >( decoded.size() ) );
+
+    const Message unknown{ 1, 1.0f };
+    check( bridge.encode( &unknown, 1, packet ) == 0, "osc encode unknown Address" );
+
+    // message of all argument types, in a bundle nested in a bundle, after a message of unknown path
+    std :: vector< char > message;
+    append_string( message, "/synth/3/value" );
+    append_string( message, ",ifsdTFhb" );
+    append_word( message, static_cast< std :: uint32_t >( -7 ) );
+    append_word( message, 0x3FC00000 );
+    append_string( message, "text" );
+    append_word( message, 0x40040000 );
+    append_word( message, 0 );
+    append_word( message, 0xFFFFFFFF );
+    append_word( message, 0xFFFFFFFE );
+    append_word( message, 5 );
+    message.insert( message.end(), 8, '\x55' );
+
+    std :: vector< char > other;
+    append_string( other, "/other" );
+    append_string( other, ",f" );
+    append_word( other, 0x3F800000 );
+
+    std :: vector< char > inner;
+    append_string( inner, "#bundle" );
+    append_word( inner, 0 );
+    append_word( inner, 1 );
+    append_word( inner, static_cast< std :: uint32_t >( other.size() ) );
+    inner.insert( inner.end(), other.begin(), other.end() );
+    append_word( inner, static_cast< std :: uint32_t >( message.size() ) );
+    inner.insert( inner.end(), message.begin(), message.end() );
+
+    std :: vector< char > outer;
+    append_string( outer, "#bundle" );
+    append_word( outer, 0 );
+    append_word( outer, 1 );
+    append_word( outer, static_cast< std :: uint32_t >( inner.size() ) );
+    outer.insert( outer.end(), inner.begin(), inner.end() );
+
+    const std :: uint64_t          before   = bridge.unknown();
+    std :: vector< Message >       types;
+    const std :: vector< Message > expected = {
+        { 12, -7.0f }, { 13, 1.5f }, { 15, 2.5f }, { 16, 1.0f }, { 17, 0.0f }, { 18, -2.0f }
+    };
+    check( bridge.decode( outer.data(), outer.size(), types ), "osc decode nested bundle" );
+    check( same( types, expected ),                            "osc argument types",       static_cast< long long >( types.size() ) );
+    check( bridge.unknown() == before + 1,                     "osc unknown path counted", static_cast< long long >( bridge.unknown() - before ) );
+
+    // every truncation is rejected without reading over the packet, except bundle header alone which is an empty bundle
+    std :: size_t accepted = 0;
+    for( std :: size_t length = 0 ; length < outer.size() ; length += length == 15 ? 2 : 1 ){
+      std :: vector< char >    truncated( outer.begin(), outer.begin() + length );
+      std :: vector< Message > ignored;
+      accepted += bridge.decode( truncated.data(), truncated.size(), ignored ) ? 1 : 0;
+    }
+    check( accepted == 0, "osc truncated packets rejected", static_cast< long long >( accepted ) );
+  }
+
+
+
+  /**
+   * @brief Serialized_SysExSender and Serialized_SysExParser round trip with partial pulls, size bound,
+   *        latency and real-time octets inside SysEx
+   */
+  void test_sysex( void ){
+
+    std :: mt19937 random( 49 );
+
+    using clock = Serialized_SysExSender :: clock;
+
+    constexpr std :: size_t MAX_SIZE = 100;
+
+    Serialized_SysExSender sender( MAX_SIZE, std :: chrono :: milliseconds( 1 ) );
+    Serialized_SysExParser parser;
+
+    const std :: vector< Message > messages = random_messages( random, 50000, 1000 );
+    std :: vector< Message >       received;
+    std :: size_t                  pulls    = 0; ///< number of pulls
+    std :: size_t                  whole    = 0; ///< pulls of whole SysEx messages only
+    std :: size_t                  oversize = 0; ///< SysEx messages over MAX_SIZE
+    clock :: time_point            now      = clock :: time_point();
+
+    const auto receive = [ & ]( const Serialized :: value_type* octets, const std :: size_t length ){
+      std :: size_t start = 0;
+      for( std :: size_t i = 0 ; i < length ; ++ i ){
+        if( octets[ i ] == Serialized_SysEx :: START )
+          start = i;
+        if( octets[ i ] == Serialized_SysEx :: END && i + 1 - start > MAX_SIZE )
+          ++ oversize;
+
+        Message message;
+        if( parser.parse( octets[ i ], message ) )
+          received.push_back( message );
+        if( random() % 50 == 0 )
+          parser.parse( static_cast< Serialized :: value_type >( 0xF8 ), message );
+      }
+    };
+
+    for( std :: size_t next = 0 ; next < messages.size() ; ){
+
+      for( std :: size_t i = random() % 20 ; i != 0 && next < messages.size() ; -- i )
+        sender.push( messages[ next ++ ], now );
+      now += std :: chrono :: microseconds( random() % 300 );
+      sender.poll( now );
+
+      // partial pulls, smaller than the queued octets
+      Serialized :: value_type octets[ MAX_SIZE * 2 ];
+      const std :: size_t      length = sender.pull( octets, random() % sizeof( octets ) + 1 );
+      ++ pulls;
+      whole += length == 0 || (octets[ 0 ] == Serialized_SysEx :: START && octets[ length - 1 ] == Serialized_SysEx :: END) ? 1 : 0;
+      receive( octets, length );
+    }
+    sender.flush();
+    for( Serialized :: value_type octets[ MAX_SIZE ] ; sender.count() != 0 ; )
+      receive( octets, sender.pull( octets, sizeof( octets ) ) );
+
+    check( same( received, messages ),                     "sysex round trip",          static_cast< long long >( received.size() ) );
+    check( whole == pulls,                                 "sysex pulls whole SysEx",   static_cast< long long >( pulls - whole ) );
+    check( oversize == 0,                                  "sysex max size",            static_cast< long long >( oversize ) );
+    check( parser.aborted() == 0 && parser.invalid() == 0, "sysex no aborted SysEx",    static_cast< long long >( parser.aborted() ) );
+    check( sender.ready() == 0 && sender.pending() == 0,   "sysex all pulled",          static_cast< long long >( sender.ready() ) );
+
+    // latency finishes a SysEx message, bulk frames stay in one SysEx message
+    Serialized_SysExSender latency( 1000, std :: chrono :: milliseconds( 1 ) );
+    latency.push( messages[ 0 ], now );
+    check( ! latency.poll( now + std :: chrono :: microseconds( 999 ) ) && latency.poll( now + std :: chrono :: milliseconds( 1 ) ), "sysex latency" );
+
+    Serialized_SysExSender packing( 1000 );
+    std :: vector< Data >  run( 100 );
+    for( Data& data : run )
+      data = random_data( random );
+    Octets bulk( Serialized_Bulk :: size( run.size() ) );
+    Serialized_Bulk :: encode( 500, run.data(), run.size(), bulk.data() );
+
+    packing.push( messages[ 0 ], now );
+    packing.push( bulk.data(), bulk.size(), now );
+    check( packing.count() == 0,                                    "sysex bulk packed with message" );
+    packing.push( bulk.data(), bulk.size(), now );
+    check( packing.count() == 1 && packing.pending() > bulk.size(), "sysex bulk not split", static_cast< long long >( packing.count() ) );
+    check( ! packing.push( Octets( 1000, 0 ).data(), 1000, now ),   "sysex frames over max size refused" );
+  }
+
+
+
+  /**
+   * @brief frame words by the layout of the previous 8 bit encoder, bit b of value octets goes to bit b % PAYLOAD of word b / PAYLOAD
+   *
+   * @tparam    Frame   Serialized or Serialized_16
+   *
+   * @param[in] value     octets of 32 bits value in memory order
+   * @param[in] address   true for Address class frame, all padding bits are 1 and then replaced by kind
+   * @param[in] kind      kind of Address class frame
+   */
+  template < typename Frame >
+  std :: vector< typename Frame :: value_type > reference_frame( const void* value, const bool address, const typename Frame :: value_type kind ){
+
+    using word = typename Frame :: value_type;
+
+    constexpr std :: size_t PAYLOAD = sizeof( word ) * 8 - 1;
+
+    std :: vector< word > words( Frame :: SIZE, 0 );
+    for( std :: size_t bit = 0 ; bit < 32 ; ++ bit )
+      if( (static_cast< const std :: uint8_t* >( value )[ bit / 8 ] >> (bit % 8)) & 1 )
+        words[ bit / PAYLOAD ] = static_cast< word >( words[ bit / PAYLOAD ] | 1u << (bit % PAYLOAD) );
+
+    if( address ){
+      for( word& w : words )
+        w = static_cast< word >( w | 1u << PAYLOAD );
+      for( std :: size_t bit = 32 - (Frame :: SIZE - 1) * PAYLOAD ; bit < PAYLOAD ; ++ bit )
+        words.back() = static_cast< word >( words.back() | 1u << bit );
+      words.back() = static_cast< word >( (words.back() & ~Frame :: KIND_MASK) | kind );
+    }
+    return words;
+  }
+
+  /**
+   * @brief frame matches reference words and decodes to the value
+   */
+  template < typename Frame, typename Value >
+  bool same_frame( const Frame& frame, const Value value, const bool address, const typename Frame :: value_type kind ){
+
+    const std :: vector< typename Frame :: value_type > expected = reference_frame< Frame >( &value, address, kind );
+    for( std :: size_t i = 0 ; i < Frame :: SIZE ; ++ i )
+      if( frame[ i ] != expected[ i ] )
+        return false;
+
+    Frame copy( frame );
+    Value decoded;
+    copy.decode( decoded );
+    return std :: memcmp( &decoded, &value, sizeof( Value ) ) == 0
+        && (address ? copy.is_address( kind ) : copy.is_data());
+  }
+
+  /**
+   * @brief 8 bit frames are same as previous encoder, Serialized_16 frames round trip with kinds in top padding bits
+   */
+  template < typename Frame >
+  std :: size_t wrong_frames( std :: mt19937& random, const std :: size_t count ){
+
+    const typename Frame :: value_type kinds[] = {
+        Frame :: KIND_ADDRESS, Frame :: KIND_BULK,  Frame :: KIND_QUANTIZED_14, Frame :: KIND_QUANTIZED_21
+      , Frame :: KIND_CHECK,   Frame :: KIND_SYNC,  Frame :: KIND_CREDIT
+    };
+
+    std :: size_t wrong = 0;
+    for( std :: size_t i = 0 ; i < count ; ++ i ){
+
+      const Address address = i < 2 ? static_cast< Address >( i == 0 ? 0 : ~0u ) : static_cast< Address >( random() );
+      const Data    data    = random_data( random );
+      const auto    kind    = kinds[ random() % (sizeof( kinds ) / sizeof( kinds[ 0 ] )) ];
+
+      Frame frame;
+      frame.encode( address );
+      wrong += same_frame( frame, address, true, Frame :: KIND_ADDRESS ) ? 0 : 1;
+      frame.encode( address, kind );
+      wrong += same_frame( frame, address, true, kind ) ? 0 : 1;
+      frame.encode( data );
+      wrong += same_frame( frame, data, false, 0 ) ? 0 : 1;
+    }
+    return wrong;
+  }
+
+  void test_words( void ){
+
+    std :: mt19937 random( 50 );
+
+    static_assert( Serialized :: SIZE == 5 && Serialized_16 :: SIZE == 3, "frame sizes" );
+    static_assert( Serialized_16 :: HEADER_BIT == 0x8000 && Serialized_16 :: KIND_ADDRESS == 0x7000, "16 bit header and kind" );
+
+    const std :: size_t wrong8  = wrong_frames< Serialized    >( random, 100000 );
+    const std :: size_t wrong16 = wrong_frames< Serialized_16 >( random, 100000 );
+    check( wrong8  == 0, "words 8 bit frames same as previous encoder", static_cast< long long >( wrong8 ) );
+    check( wrong16 == 0, "words 16 bit frames round trip",              static_cast< long long >( wrong16 ) );
+  }
+
+
+
+  /**
+   * @brief read protobuf varint
+   */
+  std :: uint64_t read_varint( const std :: string& input, std :: size_t& position ){
+    std :: uint64_t result = 0;
+    for( unsigned int shift = 0 ; position < input.size() && shift < 64 ; shift += 7 ){
+      const unsigned char octet = static_cast< unsigned char >( input[ position ++ ] );
+      result |= static_cast< std :: uint64_t >( octet & 0x7F ) << shift;
+      if( (octet & 0x80) == 0 )
+        break;
+    }
+    return result;
+  }
+
+  /**
+   * @brief Trace keeps the latest CAPACITY events of a thread, exports a time window, and drops rings of exited threads
+   */
+  void test_trace( void ){
+
+    constexpr std :: uint64_t BASE = 1ULL << 60; ///< far from now(), other events are out of windows
+
+    std :: vector< Trace :: Event > events;
+
+    Trace :: arm( true );
+
+    // wraparound, oldest events are overwritten
+    std :: thread( [](){
+        for( std :: uint64_t i = 0 ; i < Trace :: CAPACITY + 100 ; ++ i )
+          Trace :: record( Trace :: PARSE, BASE + i, BASE + i + 1, static_cast< Address >( i ), 1 );
+      } ).join();
+
+    Trace :: collect( BASE + 200, BASE + 299, events );
+    check( events.size() == 100 && events.front().start == BASE + 200 && events.back().address == 299 && events.front().duration == 1, "trace window", static_cast< long long >( events.size() ) );
+
+    events.clear();
+    Trace :: collect( BASE, BASE + Trace :: CAPACITY * 2, events );
+    check( events.size() == Trace :: CAPACITY && events.front().start == BASE + 100, "trace wraparound keeps latest", static_cast< long long >( events.size() ) );
+
+    bool sorted = true;
+    for( std :: size_t i = 1 ; i < events.size() ; ++ i )
+      sorted = sorted && events[ i - 1 ].start < events[ i ].start;
+    check( sorted, "trace events sorted" );
+
+    events.clear();
+    Trace :: collect( BASE, BASE + Trace :: CAPACITY * 2, events );
+    check( events.empty(), "trace exited ring dropped after export", static_cast< long long >( events.size() ) );
+
+
+    // exports of a complete event and an instant event, a later event keeps the ring
+    const std :: uint64_t window = BASE + (1ULL << 40);
+    std :: thread( [ window ](){
+        Trace :: name_thread( "json \"q\"" );
+        Trace :: record( Trace :: DECODE,   window,           window + 1500,    7, 3 );
+        Trace :: record( Trace :: DISPATCH, window + 500,     window + 500 );
+        Trace :: record( Trace :: WRITE,    window + 1000000, window + 1000000 );
+      } ).join();
+
+    std :: ostringstream json;
+    const std :: size_t written = Trace :: write_chrome( json, window, window + 1000 );
+    const std :: string text    = json.str();
+    check( written == 2, "trace chrome events", static_cast< long long >( written ) );
+    check( text.find( "\"name\":\"decode\"" )           != std :: string :: npos
+        && text.find( "\"ph\":\"X\"" )                  != std :: string :: npos
+        && text.find( "\"dur\":1.500" )                  != std :: string :: npos
+        && text.find( "\"ph\":\"i\"" )                  != std :: string :: npos
+        && text.find( "\"address\":7,\"count\":3" )     != std :: string :: npos
+        && text.find( "json \\\"q\\\"" )               != std :: string :: npos
+        && text.find( "\"name\":\"write\"" )            == std :: string :: npos
+        && text.compare( 0, 19, "{\"displayTimeUnit\":" ) == 0
+        && text.size() >= 3 && text.compare( text.size() - 3, 3, "]}\n" ) == 0, "trace chrome json" );
+
+    // Trace packets: descriptors, then begin, instant and end by time
+    std :: ostringstream proto( std :: ios :: binary );
+    const std :: size_t              sliced = Trace :: write_perfetto( proto, window, window + 1000 );
+    const std :: string              octets = proto.str();
+    std :: vector< std :: uint64_t > times;
+    std :: size_t                    descriptors = 0;
+    bool                             valid       = true;
+
+    for( std :: size_t position = 0 ; valid && position < octets.size() ; ){
+      valid = read_varint( octets, position ) == (1 << 3 | 2);
+      const std :: size_t end = position + read_varint( octets, position );
+      valid = valid && end <= octets.size();
+
+      std :: uint64_t time  = 0;
+      bool            track = false;
+      while( valid && position < end ){
+        const std :: uint64_t tag = read_varint( octets, position );
+        if( (tag & 7) == 0 ){
+          const std :: uint64_t value = read_varint( octets, position );
+          time = (tag >> 3) == 8 ? value : time;
+        }
+        else if( (tag & 7) == 2 ){
+          position += read_varint( octets, position );
+          track        = track || (tag >> 3) == 11;
+          descriptors += (tag >> 3) == 60 ? 1 : 0;
+        }
+        else
+          valid = false;
+      }
+      valid = valid && position == end;
+      if( track )
+        times.push_back( time );
+    }
+    check( sliced == 2 && valid && descriptors >= 1, "trace perfetto packets", static_cast< long long >( octets.size() ) );
+    check( times.size() == 3 && times[ 0 ] == window && times[ 1 ] == window + 500 && times[ 2 ] == window + 1500, "trace perfetto slices", static_cast< long long >( times.size() ) );
+
+
+    // thread churn without export keeps only EXITED rings
+    const std :: uint64_t churn = BASE + (1ULL << 50);
+    for( std :: size_t i = 0 ; i < 100 ; ++ i )
+      std :: thread( [ churn ](){ Trace :: record( Trace :: ENQUEUE, churn, churn ); } ).join();
+
+    events.clear();
+    Trace :: collect( churn, churn, events );
+    check( events.size() == Trace :: EXITED, "trace exited rings bounded", static_cast< long long >( events.size() ) );
+
+    Trace :: arm( false );
+    std :: thread( [ churn ](){ Trace :: record( Trace :: ENQUEUE, churn, churn ); } ).join();
+
+    events.clear();
+    Trace :: collect( churn, churn, events );
+    check( events.empty(), "trace disarmed", static_cast< long long >( events.size() ) );
+  }
+
+
+
+  /**
+   * @brief RateLimiter passes bursts and rate of each bucket, over wraparound of now, fine rates and eviction
+   */
+  void test_ratelimit( void ){
+
+    using Limiter = RateLimiter< 64 >;
+
+    {
+      Limiter limiter( 1000, 3 );
+      const bool burst = limiter.admit( 1, 0 ) == Limiter :: PASS && limiter.admit( 1, 0 ) == Limiter :: PASS && limiter.admit( 1, 0 ) == Limiter :: PASS;
+      check( burst && limiter.admit( 1, 0 ) == Limiter :: DEFER,                        "ratelimit burst then defer" );
+      check( limiter.admit( 2, 0 ) == Limiter :: PASS,                                  "ratelimit other Address" );
+      check( limiter.admit( 1, 999 ) == Limiter :: DEFER && limiter.admit( 1, 1000 ) == Limiter :: PASS, "ratelimit refill" );
+      check( limiter.passed() == 5 && limiter.deferred() == 2 && limiter.dropped() == 0, "ratelimit counters" );
+    }
+
+    {
+      Limiter limiter( 1000, 1, 4, true );
+      check( limiter.admit( 0x10, 0 ) == Limiter :: PASS && limiter.admit( 0x1F, 0 ) == Limiter :: DROP, "ratelimit range shift shares bucket" );
+      check( limiter.admit( 0x20, 0 ) == Limiter :: PASS && limiter.dropped() == 1,                      "ratelimit range shift drop" );
+    }
+
+    {
+      const std :: uint32_t start = 0xFFFFFF00;
+      Limiter limiter( 1000, 1 );
+      check( limiter.admit( 1, start ) == Limiter :: PASS && limiter.admit( 1, start + 500 ) == Limiter :: DEFER, "ratelimit wraparound defer" );
+      check( limiter.admit( 1, start + 1000 ) == Limiter :: PASS,                                                 "ratelimit wraparound refill" );
+    }
+
+    // rates with remainder and over MAX_RATE, one message tried each microsecond for a second
+    const std :: uint32_t rates[] = { 300000, 7, 2000000 };
+    for( const std :: uint32_t rate : rates ){
+      Limiter       limiter( rate );
+      std :: size_t passed = 0;
+      for( std :: uint32_t now = 0 ; now < 1000000 ; ++ now )
+        passed += limiter.admit( 1, now ) == Limiter :: PASS ? 1 : 0;
+      const std :: size_t expected = rate < Limiter :: MAX_RATE ? rate : Limiter :: MAX_RATE;
+      check( passed + 1 >= expected && passed <= expected + 1, "ratelimit rate", static_cast< long long >( passed ) );
+    }
+
+    // full table, a new key takes over remaining time, all keys are full again after the interval
+    {
+      RateLimiter< 4 > limiter( 1 );
+      bool first = true;
+      for( Address address = 0 ; address < 4 ; ++ address )
+        first = first && limiter.admit( address, 0 ) == RateLimiter< 4 > :: PASS;
+      check( first && limiter.evicted() == 0,                                                  "ratelimit table filled" );
+      check( limiter.admit( 100, 10 ) == RateLimiter< 4 > :: DEFER && limiter.evicted() == 1, "ratelimit eviction keeps debt" );
+
+      bool refilled = true;
+      for( Address address = 0 ; address < 4 ; ++ address )
+        refilled = refilled && limiter.admit( address, 1000000 ) == RateLimiter< 4 > :: PASS;
+      check( refilled, "ratelimit refilled after eviction" );
+    }
+  }
+
+
+
+  /**
+   * @brief FrameBuffer octets are same as Serialized frames, over partial ranges and broken entries
+   */
+  void test_framebuffer( void ){
+
+    std :: mt19937 random( 42 );
+
+    constexpr std :: size_t COUNT = 300;
+
+    std :: vector< Message > messages = random_messages( random, COUNT, 0xFFFFFFFF );
+    messages[ 0 ].address = 0xFFFFFFFF;
+
+    const auto reference = [ &messages ](){
+      Octets result;
+      for( const Message& message : messages )
+        append( result, message );
+      return result;
+    };
+
+    FrameBuffer buffer;
+    buffer.append( messages.data(), COUNT, 5 );
+    Octets expected = reference();
+    check( buffer.octet_size() == expected.size() && std :: memcmp( buffer.octets(), expected.data(), expected.size() ) == 0, "framebuffer append same as Serialized" );
+    check( buffer.timestamps()[ COUNT - 1 ] == 5 && buffer.kinds()[ 0 ] == Serialized :: KIND_ADDRESS,                         "framebuffer append arrays" );
+
+    // partial encode keeps octets around the range, including padding after the last entry
+    std :: size_t wrong = 0;
+    for( std :: size_t round = 0 ; round < 200 ; ++ round ){
+      const std :: size_t first = random() % (COUNT + 1);
+      const std :: size_t count = random() % (COUNT - first + 1);
+      for( std :: size_t i = first ; i < first + count ; ++ i ){
+        messages[ i ] = Message{ static_cast< Address >( random() ), random_data( random ) };
+        buffer.addresses()[ i ] = messages[ i ].address;
+        buffer.data()     [ i ] = messages[ i ].data;
+      }
+      buffer.encode( first, count );
+      expected = reference();
+      wrong += std :: memcmp( buffer.octets(), expected.data(), expected.size() ) == 0 ? 0 : 1;
+      for( std :: size_t i = 0 ; i < FrameBuffer :: PADDING ; ++ i )
+        wrong += buffer.octets()[ expected.size() + i ] == 0 ? 0 : 1;
+    }
+    check( wrong == 0, "framebuffer partial encode", static_cast< long long >( wrong ) );
+
+    // encoded frames of other kinds and broken entries
+    Octets input = expected;
+    {
+      Serialized bulk;
+      bulk.encode( messages[ 1 ].address, Serialized :: KIND_BULK );
+      for( std :: size_t i = 0 ; i < Serialized :: SIZE ; ++ i )
+        input[ FrameBuffer :: STRIDE + i ] = bulk[ i ];
+    }
+    input[ FrameBuffer :: STRIDE * 10 + 2 ]                          &= 0x7F; // Address octet without header bit
+    input[ FrameBuffer :: STRIDE * 20 + Serialized :: SIZE + 1 ]     |= 0x80; // Data octet with header bit
+    input[ FrameBuffer :: STRIDE * 30 + Serialized :: SIZE * 2 - 1 ] |= 0x70; // Data frame with padding bits
+
+    FrameBuffer decoded;
+    const std :: size_t invalid = decoded.append_encoded( input.data(), COUNT, 9 );
+    check( invalid == 3, "framebuffer broken entries", static_cast< long long >( invalid ) );
+
+    std :: size_t mismatch = 0;
+    for( std :: size_t i = 0 ; i < COUNT ; ++ i ){
+      const bool broken = i == 10 || i == 20 || i == 30;
+      const Serialized :: value_type kind = broken ? FrameBuffer :: INVALID : i == 1 ? Serialized :: KIND_BULK : Serialized :: KIND_ADDRESS;
+      mismatch += decoded.kinds()[ i ] == kind && decoded.timestamps()[ i ] == 9 ? 0 : 1;
+      if( ! broken )
+        mismatch += decoded.addresses()[ i ] == messages[ i ].address && same( decoded.data()[ i ], messages[ i ].data ) ? 0 : 1;
+    }
+    check( mismatch == 0, "framebuffer append_encoded same as Serialized", static_cast< long long >( mismatch ) );
+
+    // partial decode changes entries of the range only
+    decoded.octets()[ FrameBuffer :: STRIDE * 50 ]                          = 0;
+    decoded.octets()[ FrameBuffer :: STRIDE * 60 + Serialized :: SIZE + 4 ] = 0x70;
+    const std :: size_t ranged = decoded.decode( 40, 15 );
+    check( ranged == 1 && decoded.kinds()[ 50 ] == FrameBuffer :: INVALID && decoded.kinds()[ 60 ] == Serialized :: KIND_ADDRESS, "framebuffer partial decode", static_cast< long long >( ranged ) );
+    check( decoded.decode() == 5 && decoded.kinds()[ 60 ] == FrameBuffer :: INVALID,                                             "framebuffer decode all" );
+  }
+
+
+
+#if __cplusplus >= 202002L && defined( __linux__ ) && __has_include( <coroutine> )
+
+  /**
+   * @brief receive messages one by one until end of file
+   */
+  Session receive_each( Serialized_AsyncReceiver& receiver, std :: vector< Message >& output, bool& finished ){
+    while( const std :: optional< Message > message = co_await receiver.next() )
+      output.push_back( *message );
+    finished = true;
+  }
+
+  /**
+   * @brief receive messages by batches until end of file
+   */
+  Session receive_batches( Serialized_AsyncReceiver& receiver, std :: vector< Message >& output, bool& finished ){
+    Message batch[ 7 ];
+    while( const std :: size_t count = co_await receiver.next_batch( batch ) )
+      output.insert( output.end(), batch, batch + count );
+    finished = true;
+  }
+
+  /**
+   * @brief Serialized_AsyncReceiver next() and next_batch() over a socket, with writes splitting frames and end of file
+   */
+  void test_async( void ){
+
+    std :: mt19937 random( 35 );
+
+    const std :: vector< Message > messages = random_messages( random, 2000, 16 );
+    Octets stream;
+    for( const Message& message : messages )
+      append( stream, message );
+
+    // a truncated Address frame at end of file is discarded
+    const Serialized truncated( static_cast< Address >( 3 ) );
+    stream.insert( stream.end(), truncated.begin(), truncated.begin() + 3 );
+
+    for( int batch = 0 ; batch < 2 ; ++ batch ){
+
+      int fds[ 2 ];
+      if( ! check( socketpair( AF_UNIX, SOCK_STREAM, 0, fds ) == 0, "async socketpair" ) )
+        return;
+
+      EventLoop                loop;
+      Serialized_AsyncReceiver receiver( loop, fds[ 0 ] );
+      std :: vector< Message > received;
+      bool                     finished = false;
+
+      // half of stream is buffered before the session starts, so the first awaits complete without suspend
+      std :: size_t position = stream.size() / 2 + 1;
+      const bool    written  = write( fds[ 1 ], stream.data(), position ) == static_cast< ssize_t >( position );
+
+      if( batch == 0 )
+        receive_each( receiver, received, finished );
+      else
+        receive_batches( receiver, received, finished );
+
+      std :: size_t partial = 0;
+      while( position < stream.size() ){
+        const std :: size_t length = std :: min< std :: size_t >( stream.size() - position, 1 + random() % 23 );
+        partial  += write( fds[ 1 ], stream.data() + position, length ) == static_cast< ssize_t >( length ) ? 0 : 1;
+        position += length;
+        loop.run_once( 0 );
+      }
+      close( fds[ 1 ] );
+
+      for( int i = 0 ; i < 100 && ! finished ; ++ i )
+        loop.run_once( 100 );
+
+      const char* what = batch == 0 ? "async next round trip" : "async next_batch round trip";
+      check( written && partial == 0 && finished && receiver.eof(), what, static_cast< long long >( received.size() ) );
+      check( same( received, messages ),                             what, static_cast< long long >( received.size() ) );
+      close( fds[ 0 ] );
+    }
+  }
+
+#endif
+
+
+
+  /**
+   * @brief Serialized_ReceivePipeline gives same messages as one Serialized_Parser, sleeps while idle,
+   *        restarts with all batches, and stops with blocking reader by waker
+   */
+  void test_pipeline( void ){
+
+    std :: mt19937 random( 33 );
+
+    Octets                   stream;
+    Serialized_RunningStatus sender( 16 );
+    for( const Message& message : random_messages( random, 300000, 5 ) ){
+      Serialized :: value_type frames[ Serialized_RunningStatus :: MAX_SIZE ];
+      stream.insert( stream.end(), frames, frames + sender.encode( message, frames ) );
+    }
+    const std :: size_t            half   = stream.size() / 2;
+    std :: vector< Message >       serial = parse( Octets( stream.begin(), stream.begin() + half ) );
+    const std :: vector< Message > second = parse( Octets( stream.begin() + half, stream.end() ) );
+    serial.insert( serial.end(), second.begin(), second.end() );
+
+    std :: mutex               mutex;
+    std :: condition_variable  condition;
+    std :: size_t              position = 0;     ///< next octet of stream to read
+    std :: size_t              limit    = 0;     ///< octets reader may read
+    bool                       woken    = false; ///< true after waker
+    std :: vector< Message >   received;
+
+    Serialized_ReceivePipeline pipeline(
+          [ & ]( Serialized :: value_type* buffer, const std :: size_t capacity ) -> std :: size_t {
+            std :: unique_lock< std :: mutex > lock( mutex );
+            condition.wait( lock, [ & ]{ return position < limit || woken; } );
+            const std :: size_t size = std :: min( capacity, std :: min( limit - position, static_cast< std :: size_t >( random() % 3000 + 1 ) ) );
+            std :: copy( stream.begin() + position, stream.begin() + position + size, buffer );
+            position += size;
+            return size;
+          }
+        , [ & ]( const Message* messages, const std :: size_t count ){
+            received.insert( received.end(), messages, messages + count );
+          }
+        , [ & ]{
+            std :: lock_guard< std :: mutex > lock( mutex );
+            woken = true;
+            condition.notify_all();
+          } );
+
+    const auto feed = [ & ]( const std :: size_t size ){
+      {
+        std :: lock_guard< std :: mutex > lock( mutex );
+        limit = size;
+      }
+      condition.notify_all();
+    };
+    const auto settle = [ & ]( const std :: size_t count ){
+      const auto until = std :: chrono :: steady_clock :: now() + std :: chrono :: seconds( 10 );
+      while( pipeline.messages() < count && std :: chrono :: steady_clock :: now() < until )
+        std :: this_thread :: sleep_for( std :: chrono :: milliseconds( 1 ) );
+    };
+
+    pipeline.start();
+    feed( half );
+    settle( serial.size() - second.size() );
+
+    const std :: clock_t     cpu  = std :: clock();
+    std :: this_thread :: sleep_for( std :: chrono :: milliseconds( 300 ) );
+    const double idle = static_cast< double >( std :: clock() - cpu ) / CLOCKS_PER_SEC;
+    check( idle < 0.03, "pipeline idle stages sleep", static_cast< long long >( idle * 1000 ) );
+
+    pipeline.stop();
+    {
+      std :: lock_guard< std :: mutex > lock( mutex );
+      woken = false;
+    }
+    pipeline.start();
+    feed( stream.size() );
+
+    settle( serial.size() );
+    pipeline.stop();
+
+    check( same( received, serial ),                "pipeline same as one parser per run",       static_cast< long long >( received.size() ) );
+    check( pipeline.octets() == stream.size(),      "pipeline octets",                           static_cast< long long >( pipeline.octets() ) );
+  }
+
+
+
+  /**
+   * @brief a named test
+   */
+  struct Test {
+    const char* name;           ///< name of test
+    void        (*run)( void ); ///< test function
+  };
+
+  const Test tests[] = {
+      { "bulk",         test_bulk         }
+    , { "quantized",    test_quantized    }
+    , { "short",        test_short        }
+    , { "parser",       test_parser       }
+    , { "priority",     test_priority     }
+    , { "parallel",     test_parallel     }
+    , { "pool",         test_pool         }
+    , { "integrity",    test_integrity    }
+    , { "state",        test_state        }
+    , { "router",       test_router       }
+    , { "subscription", test_subscription }
+    , { "smoother",     test_smoother     }
+    , { "schema",       test_schema       }
+    , { "shared",       test_shared       }
+    , { "events",       test_events       }
+    , { "credit",       test_credit       }
+    , { "osc",          test_osc          }
+    , { "sysex",        test_sysex        }
+    , { "words",        test_words        }
+    , { "trace",        test_trace        }
+    , { "ratelimit",    test_ratelimit    }
+    , { "framebuffer",  test_framebuffer  }
+#if __cplusplus >= 202002L && defined( __linux__ ) && __has_include( <coroutine> )
+    , { "async",        test_async        }
+#endif
+    , { "pipeline",     test_pipeline     }
+  };
+
+}
+
+
+int main( int argc, const char* argv[] ){
+
+  std :: size_t failed_tests = 0;
+
+  for( const Test& test : tests ){
+
+    bool selected = argc < 2;
+    for( int i = 1 ; i < argc ; ++ i )
+      selected = selected || std :: strcmp( argv[ i ], test.name ) == 0;
+    if( ! selected )
+      continue;
+
+    checks = 0;
+    failed = 0;
+    std :: printf( "%s\n", test.name );
+    test.run();
+    std :: printf( "  %zu checks, %zu failed\n", checks, failed );
+
+    if( failed != 0 )
+      ++ failed_tests;
+  }
+
+  return failed_tests == 0 ? 0 : 1;
+}